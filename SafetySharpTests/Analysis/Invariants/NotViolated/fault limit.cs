@@ -0,0 +1,74 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace Tests.Analysis.Invariants.NotViolated
+{
+	using SafetySharp.Modeling;
+	using ISSE.SafetyChecking.Modeling;
+	using Shouldly;
+
+	internal class FaultLimit : AnalysisTestObject
+	{
+		protected override void Check()
+		{
+			var c = new C();
+
+			LimitOfActiveFaults = 1;
+			CheckInvariant(c.X != 30, c).ShouldBe(true);
+			CheckInvariant(c.X != 12, c).ShouldBe(false);
+			CheckInvariant(c.X != 21, c).ShouldBe(false);
+
+			LimitOfActiveFaults = 2;
+			CheckInvariant(c.X != 30, c).ShouldBe(false);
+
+			LimitOfActiveFaults = null;
+			CheckInvariant(c.X != 30, c).ShouldBe(false);
+		}
+
+		private class C : Component
+		{
+			public int X;
+
+			protected virtual int Y1 => 1;
+			protected virtual int Y2 => 2;
+
+			public Fault F1 = new TransientFault();
+			public Fault F2 = new TransientFault();
+
+			public override void Update()
+			{
+				X = Y1 + Y2;
+			}
+
+			[FaultEffect(Fault = nameof(F1))]
+			public class E1 : C
+			{
+				protected override int Y1 => 10;
+			}
+
+			[FaultEffect(Fault = nameof(F2))]
+			public class E2 : C
+			{
+				protected override int Y2 => 20;
+			}
+		}
+	}
+}
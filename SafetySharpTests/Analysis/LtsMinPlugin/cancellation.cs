@@ -0,0 +1,65 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace Tests.Analysis.LtsMinPlugin
+{
+	using System;
+	using System.Threading;
+	using ISSE.SafetyChecking.AnalysisModel;
+	using SafetySharp.Analysis;
+	using SafetySharp.Modeling;
+	using SafetySharp.Runtime;
+	using Shouldly;
+	using Utilities;
+
+	internal class Cancellation : AnalysisTestObject
+	{
+		protected override void Check()
+		{
+			var c = new C();
+			var ltsMin = new LtsMin();
+
+			using (var cancellation = new CancellationTokenSource())
+			{
+				cancellation.Cancel();
+
+				var createModel = SafetySharpRuntimeModel.CreateExecutedModelCreator(TestModel.InitializeModel(c), c.X != 5);
+				var result = ltsMin.Check(createModel, c.X != 5, cancellation.Token);
+
+				result.Termination.ShouldBe(LtsMinTermination.Canceled);
+				result.Verdict.ShouldBe(InvariantVerdict.Unknown);
+				result.IsConclusive.ShouldBe(false);
+				Should.Throw<InvalidOperationException>(() => result.FormulaHolds.ShouldBe(false));
+			}
+		}
+
+		private class C : Component
+		{
+			[Range(0, 10, OverflowBehavior.Clamp)]
+			public int X;
+
+			public override void Update()
+			{
+				++X;
+			}
+		}
+	}
+}
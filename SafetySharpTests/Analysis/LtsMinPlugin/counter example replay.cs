@@ -0,0 +1,96 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace Tests.Analysis.LtsMinPlugin
+{
+	using ISSE.SafetyChecking.Modeling;
+	using SafetySharp.Analysis;
+	using SafetySharp.Modeling;
+	using Shouldly;
+
+	internal class CounterExampleReplay : AnalysisTestObject
+	{
+		protected override void Check()
+		{
+			// Only the enumerative backends generate traces; the counter examples must be replayable regardless of whether
+			// LtsMin operates on the packed state vectors or on the variable layout
+			Check(new LtsMin { Backend = LtsMinBackend.Sequential });
+			Check(new LtsMin { Backend = LtsMinBackend.Sequential, UseVariableStateLayout = true });
+			Check(new LtsMin { Backend = LtsMinBackend.MultiCore });
+			Check(new LtsMin { Backend = LtsMinBackend.MultiCore, UseVariableStateLayout = true });
+		}
+
+		private void Check(LtsMin ltsMin)
+		{
+			// X only changes in mode B, one of the two initial states, and only reaches 5 if F is activated once. The trace's columns
+			// are matched to the state slots by name for both layouts; the trace starts in the pseudo initial state, which stores the
+			// values of the first initial state A and is dropped as the trace does not end there, so the replay must start in B
+			var c = new C();
+			var result = CheckInvariant(ltsMin, c.X != 5, c);
+
+			result.FormulaHolds.ShouldBe(false);
+			CounterExample.ShouldNotBeNull();
+			CounterExample.StepCount.ShouldBeGreaterThanOrEqualTo(3);
+
+			SimulateCounterExample(CounterExample, simulator =>
+			{
+				c = (C)simulator.Model.Roots[0];
+
+				c.Mode.State.ShouldBe(S.B);
+				c.X.ShouldBe(0);
+
+				while (!simulator.IsCompleted)
+					simulator.SimulateStep();
+
+				c.X.ShouldBe(5);
+			});
+		}
+
+		private enum S
+		{
+			A,
+			B
+		}
+
+		private class C : Component
+		{
+			public readonly Fault F = new TransientFault();
+			public readonly StateMachine<S> Mode = new StateMachine<S>(S.A, S.B);
+
+			[Range(0, 10, OverflowBehavior.Clamp)]
+			public int X;
+
+			public virtual int Increment => 2;
+
+			public override void Update()
+			{
+				if (Mode.State == S.B)
+					X += Increment;
+			}
+
+			[FaultEffect(Fault = nameof(F))]
+			public class E : C
+			{
+				public override int Increment => 3;
+			}
+		}
+	}
+}
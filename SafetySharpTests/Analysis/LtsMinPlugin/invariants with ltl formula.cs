@@ -0,0 +1,73 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace Tests.Analysis.LtsMinPlugin
+{
+	using ISSE.SafetyChecking.AnalysisModel;
+	using ISSE.SafetyChecking.Formula;
+	using SafetySharp.Analysis;
+	using SafetySharp.Modeling;
+	using SafetySharp.Runtime;
+	using Shouldly;
+	using Utilities;
+	using static SafetySharp.Analysis.Operators;
+
+	internal class InvariantsWithLtlFormula : AnalysisTestObject
+	{
+		protected override void Check()
+		{
+			var c = new C();
+			Formula firstViolated = c.X != 1;
+			Formula secondViolated = c.X != 2;
+			Formula holds = c.X <= 100;
+			var ltl = F(c.X == 50);
+
+			var ltsMin = new LtsMin();
+			var createModel = SafetySharpRuntimeModel.CreateExecutedModelCreator(TestModel.InitializeModel(c), firstViolated, secondViolated, holds, ltl);
+
+			using (var session = ltsMin.OpenSession(createModel))
+			{
+				// Neither the LTL formula nor the invariant that is not requested must keep the exploration from stopping once all
+				// requested invariants are known to be violated
+				var results = session.CheckInvariants(firstViolated, secondViolated);
+				results[0].Verdict.ShouldBe(InvariantVerdict.Violated);
+				results[1].Verdict.ShouldBe(InvariantVerdict.Violated);
+				results[0].StateCount.ShouldBeLessThan(101);
+
+				results = session.CheckInvariants(firstViolated, holds);
+				results[0].Verdict.ShouldBe(InvariantVerdict.Violated);
+				results[1].Verdict.ShouldBe(InvariantVerdict.Holds);
+				results[1].StateCount.ShouldBe(101);
+			}
+		}
+
+		private class C : Component
+		{
+			[Range(0, 100, OverflowBehavior.Clamp)]
+			public int X;
+
+			public override void Update()
+			{
+				++X;
+			}
+		}
+	}
+}
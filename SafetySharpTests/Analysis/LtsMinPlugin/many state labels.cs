@@ -0,0 +1,90 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace Tests.Analysis.LtsMinPlugin
+{
+	using ISSE.SafetyChecking.Formula;
+	using SafetySharp.Analysis;
+	using SafetySharp.Modeling;
+	using Shouldly;
+
+	internal class ManyStateLabels : AnalysisTestObject
+	{
+		protected override void Check()
+		{
+			// Labels over X are evaluated natively, labels over D by the managed formulas. The workers cache the values of the
+			// managed labels of a state as a 32 bit mask; for 32 or more managed labels, the cache is disabled and all labels
+			// are evaluated on demand instead, which must not affect the results
+			Check(nativeLabels: 0, managedLabels: 31);
+			Check(nativeLabels: 0, managedLabels: 40);
+			Check(nativeLabels: 20, managedLabels: 20);
+			Check(nativeLabels: 40, managedLabels: 0);
+		}
+
+		private void Check(int nativeLabels, int managedLabels)
+		{
+			Check(new LtsMin { Backend = LtsMinBackend.Sequential }, nativeLabels, managedLabels);
+			Check(new LtsMin { Backend = LtsMinBackend.Symbolic, UseVariableStateLayout = true }, nativeLabels, managedLabels);
+		}
+
+		private void Check(LtsMin ltsMin, int nativeLabels, int managedLabels)
+		{
+			var c = new C();
+			CheckInvariant(ltsMin, CreateInvariant(c, nativeLabels, managedLabels, violatedValue: -1), c).FormulaHolds.ShouldBe(true);
+
+			c = new C();
+			CheckInvariant(ltsMin, CreateInvariant(c, nativeLabels, managedLabels, violatedValue: 7), c).FormulaHolds.ShouldBe(false);
+		}
+
+		/// <summary>
+		///   Creates an invariant consisting of the given number of labels, the last of which is violated once X reaches the
+		///   <paramref name="violatedValue" />.
+		/// </summary>
+		private static Formula CreateInvariant(C c, int nativeLabels, int managedLabels, int violatedValue)
+		{
+			Formula invariant = null;
+			var labelCount = nativeLabels + managedLabels;
+
+			for (var i = 0; i < labelCount; ++i)
+			{
+				var value = i == labelCount - 1 ? violatedValue : 100 + i;
+				Formula label = i < nativeLabels ? c.X != value : c.D != value;
+				invariant = invariant == null ? label : invariant && label;
+			}
+
+			return invariant;
+		}
+
+		private class C : Component
+		{
+			[Range(0, 10, OverflowBehavior.Clamp)]
+			public int X;
+
+			public double D;
+
+			public override void Update()
+			{
+				++X;
+				D = X;
+			}
+		}
+	}
+}
@@ -0,0 +1,104 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace Tests.Analysis.LtsMinPlugin
+{
+	using System;
+	using System.IO;
+	using System.Threading;
+	using ISSE.SafetyChecking;
+	using ISSE.SafetyChecking.ExecutedModel;
+	using ISSE.SafetyChecking.FaultMinimalKripkeStructure;
+	using ISSE.SafetyChecking.Formula;
+	using SafetySharp.Analysis;
+	using SafetySharp.Modeling;
+	using SafetySharp.Runtime;
+	using Shouldly;
+	using Utilities;
+
+	internal class Portfolio : AnalysisTestObject
+	{
+		protected override void Check()
+		{
+			var configuration = AnalysisConfiguration.Default;
+			configuration.ModelCapacity = ModelCapacityByMemorySize.Tiny;
+			configuration.DefaultTraceOutput = Output.TextWriterAdapter();
+
+			var historyFile = Path.Combine(Path.GetTempPath(), Guid.NewGuid() + ".csv");
+			try
+			{
+				var c = new C();
+				var model = TestModel.InitializeModel(c);
+				var checker = new SafetySharpPortfolioChecker(configuration) { HistoryFile = historyFile };
+
+				var holds = checker.CheckInvariant(model, c.X <= 10);
+				holds.FormulaHolds.ShouldBe(true);
+				holds.Engine.ShouldNotBe(null);
+
+				var violated = checker.CheckInvariant(model, c.X != 5);
+				violated.FormulaHolds.ShouldBe(false);
+				violated.CounterExample.ShouldNotBe(null);
+
+				// An LtsMin run that fails must let the qualitative model checker win the race
+				checker.LtsMin = new LtsMin { Backend = LtsMinBackend.Symbolic, Strategy = LtsMinStrategy.DepthFirst };
+				var fallback = checker.CheckInvariant(model, c.X != 5);
+				fallback.FormulaHolds.ShouldBe(false);
+				fallback.Engine.ShouldBe(PortfolioEngine.QualitativeChecker);
+
+				var history = File.ReadAllLines(historyFile);
+				history.Length.ShouldBe(4);
+				history[0].ShouldBe(SafetySharpPortfolioChecker.HistoryHeader);
+				history[1].ShouldContain($",{holds.Engine},");
+				history[2].ShouldContain($",{violated.Engine},");
+				history[3].ShouldContain($",{PortfolioEngine.QualitativeChecker},");
+			}
+			finally
+			{
+				File.Delete(historyFile);
+			}
+
+			// The qualitative model checker reports a cancellation only if its traversal has been cut short
+			using (var cancellation = new CancellationTokenSource())
+			{
+				var c = new C();
+				Formula invariant = c.X <= 10;
+				var createModel = SafetySharpRuntimeModel.CreateExecutedModelCreator(TestModel.InitializeModel(c), invariant);
+				var checker = new QualitativeChecker<SafetySharpRuntimeModel>(createModel) { Configuration = configuration };
+
+				checker.CheckInvariant(invariant, cancellation.Token).FormulaHolds.ShouldBe(true);
+
+				cancellation.Cancel();
+				Should.Throw<OperationCanceledException>(() => checker.CheckInvariant(invariant, cancellation.Token));
+			}
+		}
+
+		private class C : Component
+		{
+			[Range(0, 10, OverflowBehavior.Clamp)]
+			public int X;
+
+			public override void Update()
+			{
+				++X;
+			}
+		}
+	}
+}
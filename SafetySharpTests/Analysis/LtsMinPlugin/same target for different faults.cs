@@ -0,0 +1,96 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace Tests.Analysis.LtsMinPlugin
+{
+	using ISSE.SafetyChecking.Modeling;
+	using SafetySharp.Analysis;
+	using SafetySharp.Modeling;
+	using Shouldly;
+
+	internal class SameTargetForDifferentFaults : AnalysisTestObject
+	{
+		protected override void Check()
+		{
+			// In the states with Mode and Mode2 in state A, F1 and F2 lead to the same target state; the symbolic backend must
+			// nevertheless find the same states as the sequential one, even though it reuses the successors of a transition group
+			// for all states that coincide in the slots read by the group
+			var sequential = CheckInvariant(new LtsMin { Backend = LtsMinBackend.Sequential }, new C());
+			var symbolic = CheckInvariant(new LtsMin { Backend = LtsMinBackend.Symbolic, UseVariableStateLayout = true }, new C());
+
+			// 15 reachable states plus the pseudo initial state for the multiple initial states
+			sequential.Statistics.StateCount.ShouldBe(16);
+			symbolic.Statistics.StateCount.ShouldBe(sequential.Statistics.StateCount);
+
+			// The target state is only reachable via F2, so it is lost whenever F2's transition is dropped in favor of F1's
+			var c = new C();
+			var result = CheckInvariant(new LtsMin { Backend = LtsMinBackend.Symbolic, UseVariableStateLayout = true },
+				!(c.Mode.State == S.B && c.Mode2.State == S.A && c.Y == 1), c);
+			result.FormulaHolds.ShouldBe(false);
+		}
+
+		private LtsMinAnalysisResult CheckInvariant(LtsMin ltsMin, C c)
+		{
+			var result = CheckInvariant(ltsMin, c.Y <= 5, c);
+			result.FormulaHolds.ShouldBe(true);
+
+			return result;
+		}
+
+		private enum S
+		{
+			A,
+			B
+		}
+
+		private class C : Component
+		{
+			public readonly Fault F1 = new TransientFault();
+			public readonly Fault F2 = new TransientFault();
+
+			public readonly StateMachine<S> Mode = new StateMachine<S>(S.A, S.B);
+			public readonly StateMachine<S> Mode2 = new StateMachine<S>(S.A, S.B);
+
+			[Range(0, 5, OverflowBehavior.Error)]
+			public int Y;
+
+			public virtual int V1 => 0;
+			public virtual int V2 => 0;
+
+			public override void Update()
+			{
+				Y = V1 + V2;
+			}
+
+			[FaultEffect(Fault = nameof(F1))]
+			internal class E1 : C
+			{
+				public override int V1 => Mode.State == S.A ? 1 : 2;
+			}
+
+			[FaultEffect(Fault = nameof(F2))]
+			internal class E2 : C
+			{
+				public override int V2 => Mode2.State == S.A ? 1 : 3;
+			}
+		}
+	}
+}
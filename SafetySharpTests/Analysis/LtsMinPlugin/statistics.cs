@@ -0,0 +1,108 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace Tests.Analysis.LtsMinPlugin
+{
+	using System;
+	using SafetySharp.Analysis;
+	using Shouldly;
+	using Utilities;
+
+	internal class Statistics : AnalysisTestObject
+	{
+		protected override void Check()
+		{
+			var sequential = Parse(
+				"pins2lts-seq, 0.002: Loading model from /tmp/model.ssharp",
+				"Checking 2 invariants.",
+				"pins2lts-seq, 0.120: State length is 3, there are 4 groups",
+				"pins2lts-seq, 0.121: Running bfs search strategy",
+				"pins2lts-seq, 0.121: Using a hash table with 2^24 elements",
+				"pins2lts-seq, 0.122: ~1 levels ~1 states ~4 transitions",
+				"pins2lts-seq, 0.125: ~8 levels ~64 states ~512 transitions",
+				"pins2lts-seq, 0.130: state space 12 levels, 101 states 1234 transitions",
+				"pins2lts-seq, 0.130: Exploration time 0.010 sec (0.008 sec user, 0.001 sec sys)",
+				"pins2lts-seq, 0.130: Queue width: 8B, total height: 0, memory: 3.00MB");
+
+			sequential.LevelCount.ShouldBe(12);
+			sequential.StateCount.ShouldBe(101);
+			sequential.TransitionCount.ShouldBe(1234);
+			sequential.ExplorationTime.ShouldBe(TimeSpan.FromSeconds(0.010));
+			sequential.CpuTime.ShouldBe(TimeSpan.FromSeconds(0.009));
+			sequential.PeakMemoryInBytes.ShouldBe(null);
+			sequential.FillRatio.ShouldBe(null);
+
+			var multiCore = Parse(
+				"pins2lts-mc( 0/ 4), 0.002: Loading model from /tmp/model.ssharp",
+				"pins2lts-mc( 0/ 4), 0.120: Using a tree table with 2^24 elements",
+				"pins2lts-mc( 0/ 4), 0.125: ~64 levels ~65536 states ~262144 transitions",
+				"pins2lts-mc( 0/ 4), 0.130: Explored 101 states 1234 transitions, fanout: 12.218",
+				"pins2lts-mc( 0/ 4), 0.130: Total exploration time 0.010 sec (0.010 sec minimum, 0.010 sec on average)",
+				"pins2lts-mc( 0/ 4), 0.130: States per second: 10100, Transitions per second: 123400",
+				"pins2lts-mc( 0/ 4), 0.130: State space has 101 states, 0 are accepting",
+				"pins2lts-mc( 0/ 4), 0.130: Queue width: 8B, total height: 2, memory: 512.00MB",
+				"pins2lts-mc( 0/ 4), 0.130: Tree memory: 257.0MB, 2664.8 B/state, compr.: 0.0%",
+				"pins2lts-mc( 0/ 4), 0.130: Tree fill ratio (roots/leafs): 12.5%/0.4%",
+				"pins2lts-mc( 0/ 4), 0.130: Stored 5 string chucks using 0MB",
+				"pins2lts-mc( 0/ 4), 0.130: Est. total memory use: 257.0MB (~1024.0MB paged-in)");
+
+			multiCore.LevelCount.ShouldBe(null);
+			multiCore.StateCount.ShouldBe(101);
+			multiCore.TransitionCount.ShouldBe(1234);
+			multiCore.ExplorationTime.ShouldBe(TimeSpan.FromSeconds(0.010));
+			multiCore.CpuTime.ShouldBe(null);
+			multiCore.PeakMemoryInBytes.ShouldBe((long)(257.0 * (1 << 20)));
+			multiCore.FillRatio.ShouldBe(12.5);
+
+			var symbolic = Parse(
+				"pins2lts-sym, 0.002: Loading model from /tmp/model.ssharp",
+				"pins2lts-sym, 0.120: level 0 is finished",
+				"pins2lts-sym, 0.150: level 63 is finished",
+				"pins2lts-sym, 0.150: state space has 1.2e+06 (~1234567) states, 4321 BDD nodes");
+
+			symbolic.LevelCount.ShouldBe(null);
+			symbolic.StateCount.ShouldBe(1234567);
+			symbolic.TransitionCount.ShouldBe(null);
+			symbolic.PeakMemoryInBytes.ShouldBe(null);
+
+			// Output of the plugin and of the model must never be mistaken for statistics
+			var unrelated = Parse(
+				"Model has 3 levels of subcomponents.",
+				"state space 12 levels, 101 states 1234 transitions",
+				"Explored 101 states 1234 transitions, fanout: 12.218",
+				"Est. total memory use: 257.0MB (~1024.0MB paged-in)");
+
+			unrelated.LevelCount.ShouldBe(null);
+			unrelated.StateCount.ShouldBe(null);
+			unrelated.TransitionCount.ShouldBe(null);
+			unrelated.PeakMemoryInBytes.ShouldBe(null);
+		}
+
+		private static LtsMinStatistics Parse(params string[] lines)
+		{
+			var statistics = new LtsMinStatistics();
+			foreach (var line in lines)
+				statistics.Parse(line);
+
+			return statistics;
+		}
+	}
+}
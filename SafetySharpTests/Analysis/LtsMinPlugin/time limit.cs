@@ -0,0 +1,73 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace Tests.Analysis.LtsMinPlugin
+{
+	using System;
+	using System.Diagnostics;
+	using System.Threading;
+	using ISSE.SafetyChecking.AnalysisModel;
+	using ISSE.SafetyChecking.Utilities;
+	using SafetySharp.Analysis;
+	using SafetySharp.Modeling;
+	using SafetySharp.Runtime;
+	using Shouldly;
+	using Utilities;
+
+	internal class TimeLimit : AnalysisTestObject
+	{
+		protected override void Check()
+		{
+			// The exploration of the million states takes much longer than the first check of the time limit
+			var c = new C();
+			var ltsMin = new LtsMin { TimeLimit = TimeSpan.FromMilliseconds(1) };
+			var createModel = SafetySharpRuntimeModel.CreateExecutedModelCreator(TestModel.InitializeModel(c), c.X >= 0);
+			var result = ltsMin.Check(createModel, c.X >= 0, CancellationToken.None);
+
+			result.Termination.ShouldBe(LtsMinTermination.TimedOut);
+			result.Verdict.ShouldBe(InvariantVerdict.Unknown);
+			result.Statistics.ElapsedTime.ShouldBeLessThan(TimeSpan.FromSeconds(30));
+			result.Statistics.StateCount.ShouldBe(null);
+			Should.Throw<InvalidOperationException>(() => result.FormulaHolds.ShouldBe(false));
+
+			// A process that is not allowed to continue is killed instead of being waited for
+			using (var process = new ExternalProcess("ping.exe", "-n 60 127.0.0.1"))
+			{
+				var stopwatch = Stopwatch.StartNew();
+
+				process.Run(() => false, TimeSpan.FromMilliseconds(10)).ShouldBe(false);
+				process.ExitCode.ShouldBe(-1);
+				stopwatch.Elapsed.ShouldBeLessThan(TimeSpan.FromSeconds(30));
+			}
+		}
+
+		private class C : Component
+		{
+			[Range(0, 1000000, OverflowBehavior.Clamp)]
+			public int X;
+
+			public override void Update()
+			{
+				++X;
+			}
+		}
+	}
+}
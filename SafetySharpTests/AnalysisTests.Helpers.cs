@@ -53,6 +53,8 @@ namespace Tests
 
 		protected bool AllowFaultsOnInitialTransitions { get; set; }
 
+		protected int? LimitOfActiveFaults { get; set; }
+
 		protected void SimulateCounterExample(ExecutableCounterExample<SafetySharpRuntimeModel> counterExample, Action<SafetySharpSimulator> action)
 		{
 			// Test directly
@@ -72,7 +74,7 @@ namespace Tests
 			var analysisTestsVariant = (AnalysisTestsVariant)Arguments[0];
 
 			analysisTestsVariant.SetModelCheckerParameter(SuppressCounterExampleGeneration, Output.TextWriterAdapter());
-			analysisTestsVariant.SetExecutionParameter(AllowFaultsOnInitialTransitions);
+			analysisTestsVariant.SetExecutionParameter(AllowFaultsOnInitialTransitions, LimitOfActiveFaults);
 
 			var modelCreator = SafetySharpRuntimeModel.CreateExecutedModelCreator(TestModel.InitializeModel(components), invariant);
 
@@ -91,6 +93,24 @@ namespace Tests
 			return Result.FormulaHolds;
 		}
 
+		protected LtsMinAnalysisResult CheckInvariant(LtsMin ltsMin, Formula invariant, params IComponent[] components)
+		{
+			ltsMin.Output = Output.TextWriterAdapter();
+			ltsMin.GenerateCounterExample = !SuppressCounterExampleGeneration;
+			ltsMin.AllowFaultsOnInitialTransitions = AllowFaultsOnInitialTransitions;
+			ltsMin.LimitOfActiveFaults = LimitOfActiveFaults;
+
+			var modelCreator = SafetySharpRuntimeModel.CreateExecutedModelCreator(TestModel.InitializeModel(components), invariant);
+
+			LtsMinAnalysisResult result;
+			using (var session = ltsMin.OpenSession(modelCreator))
+				result = session.CheckInvariant(invariant);
+
+			Result = result;
+			CounterExample = result.ExecutableCounterExample(modelCreator);
+			return result;
+		}
+
 		protected bool[] CheckInvariants(IComponent component, params Formula[] invariants)
 		{
 			var analysisTestsVariant = (AnalysisTestsVariant)Arguments[0];
@@ -98,7 +118,7 @@ namespace Tests
 			var modelCreator = SafetySharpRuntimeModel.CreateExecutedModelCreator(TestModel.InitializeModel(component), invariants);
 			
 			analysisTestsVariant.SetModelCheckerParameter(SuppressCounterExampleGeneration, Output.TextWriterAdapter());
-			analysisTestsVariant.SetExecutionParameter(AllowFaultsOnInitialTransitions);
+			analysisTestsVariant.SetExecutionParameter(AllowFaultsOnInitialTransitions, LimitOfActiveFaults);
 
 			var results = analysisTestsVariant.CheckInvariants(modelCreator, invariants);
 			CounterExamples = results.Select(result => result.ExecutableCounterExample(modelCreator)).ToArray();
@@ -112,7 +132,7 @@ namespace Tests
 			var modelCreator = SafetySharpRuntimeModel.CreateExecutedModelCreator(TestModel.InitializeModel(components),formula);
 			
 			analysisTestsVariant.SetModelCheckerParameter(SuppressCounterExampleGeneration, Output.TextWriterAdapter());
-			analysisTestsVariant.SetExecutionParameter(AllowFaultsOnInitialTransitions);
+			analysisTestsVariant.SetExecutionParameter(AllowFaultsOnInitialTransitions, LimitOfActiveFaults);
 
 			var result = analysisTestsVariant.Check(modelCreator,formula);
 
@@ -278,6 +298,17 @@ namespace Tests
 
 	public partial class LtsMinInvariantTests : Tests
 	{
+		/// <summary>
+		///   The tests expecting an exception raised while checking the model to be reported; LtsMin cannot report these
+		///   exceptions, as it aborts the state space exploration in that case.
+		/// </summary>
+		private static readonly string[] TestsWithExceptions =
+		{
+			"generation suppressed with exception",
+			"hidden variable with effect",
+			"initial state exception"
+		};
+
 		public LtsMinInvariantTests(ITestOutputHelper output)
 			: base(output)
 		{
@@ -288,6 +319,32 @@ namespace Tests
 		{
 			return EnumerateTestCases(GetAbsoluteTestsDirectory(directory));
 		}
+
+		[UsedImplicitly]
+		public static IEnumerable<object[]> DiscoverTestsWithoutExceptions(string directory)
+		{
+			return DiscoverTests(directory).Where(test => !TestsWithExceptions.Contains((string)test[0]));
+		}
+
+		[UsedImplicitly]
+		public static IEnumerable<object[]> DiscoverTestsWithExceptions(string directory)
+		{
+			return DiscoverTests(directory).Where(test => TestsWithExceptions.Contains((string)test[0]));
+		}
+	}
+
+	public partial class LtsMinPluginTests : Tests
+	{
+		public LtsMinPluginTests(ITestOutputHelper output)
+			: base(output)
+		{
+		}
+
+		[UsedImplicitly]
+		public static IEnumerable<object[]> DiscoverTests(string directory)
+		{
+			return EnumerateTestCases(GetAbsoluteTestsDirectory(directory));
+		}
 	}
 
 	public partial class DccaTests : Tests
@@ -44,7 +44,7 @@ namespace Tests
 	{
 		public abstract void SetModelCheckerParameter(bool suppressCounterExampleGeneration, TextWriter output);
 
-		public abstract void SetExecutionParameter(bool allowFaultsOnInitialTransitions);
+		public abstract void SetExecutionParameter(bool allowFaultsOnInitialTransitions, int? limitOfActiveFaults);
 
 		public abstract InvariantAnalysisResult[] CheckInvariants(CoupledExecutableModelCreator<SafetySharpRuntimeModel> createModel, params Formula[] invariants);
 
@@ -63,11 +63,13 @@ namespace Tests
 			// LtsMin
 			_modelChecker = new LtsMin();
 			_modelChecker.Output= output;
+			_modelChecker.GenerateCounterExample = !suppressCounterExampleGeneration;
 		}
 
-		public override void SetExecutionParameter(bool allowFaultsOnInitialTransitions)
+		public override void SetExecutionParameter(bool allowFaultsOnInitialTransitions, int? limitOfActiveFaults)
 		{
-			//TODO
+			_modelChecker.AllowFaultsOnInitialTransitions = allowFaultsOnInitialTransitions;
+			_modelChecker.LimitOfActiveFaults = limitOfActiveFaults;
 		}
 
 		public override InvariantAnalysisResult Check(CoupledExecutableModelCreator<SafetySharpRuntimeModel> createModel, Formula formula)
@@ -82,7 +84,7 @@ namespace Tests
 
 		public override InvariantAnalysisResult[] CheckInvariants(CoupledExecutableModelCreator<SafetySharpRuntimeModel> createModel, params Formula[] invariants)
 		{
-			throw new NotImplementedException();
+			return _modelChecker.CheckInvariants(createModel, invariants);
 		}
 	}
 
@@ -97,12 +99,14 @@ namespace Tests
 			_analysisConfiguration = AnalysisConfiguration.Default;
 			_analysisConfiguration.DefaultTraceOutput = output;
 			_analysisConfiguration.ModelCapacity = ModelCapacityByMemorySize.Small;
+			_analysisConfiguration.InitialSuccessorCapacity = 1024;
 			_analysisConfiguration.GenerateCounterExample = !suppressCounterExampleGeneration;
 		}
 
-		public override void SetExecutionParameter(bool allowFaultsOnInitialTransitions)
+		public override void SetExecutionParameter(bool allowFaultsOnInitialTransitions, int? limitOfActiveFaults)
 		{
 			_analysisConfiguration.AllowFaultsOnInitialTransitions = allowFaultsOnInitialTransitions;
+			_analysisConfiguration.LimitOfActiveFaults = limitOfActiveFaults;
 		}
 
 		public override InvariantAnalysisResult Check(CoupledExecutableModelCreator<SafetySharpRuntimeModel> createModel, Formula formula)
@@ -139,9 +143,10 @@ namespace Tests
 			_analysisConfiguration.GenerateCounterExample = !suppressCounterExampleGeneration;
 		}
 
-		public override void SetExecutionParameter(bool allowFaultsOnInitialTransitions)
+		public override void SetExecutionParameter(bool allowFaultsOnInitialTransitions, int? limitOfActiveFaults)
 		{
 			_analysisConfiguration.AllowFaultsOnInitialTransitions = allowFaultsOnInitialTransitions;
+			_analysisConfiguration.LimitOfActiveFaults = limitOfActiveFaults;
 		}
 
 		public override InvariantAnalysisResult Check(CoupledExecutableModelCreator<SafetySharpRuntimeModel> createModel, Formula formula)
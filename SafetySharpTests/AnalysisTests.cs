@@ -168,6 +168,28 @@ namespace Tests
 		{
 			ExecuteDynamicTests(file, _analysisTestVariant);
 		}
+
+		[Theory, MemberData(nameof(DiscoverTestsWithoutExceptions), "Analysis/Invariants/CounterExamples")]
+		public void CounterExamples(string test, string file)
+		{
+			ExecuteDynamicTests(file, _analysisTestVariant);
+		}
+
+		[Theory(Skip = "LtsMin aborts when the model throws an exception, so the exception cannot be reported."),
+		 MemberData(nameof(DiscoverTestsWithExceptions), "Analysis/Invariants/CounterExamples")]
+		public void CounterExamplesWithExceptions(string test, string file)
+		{
+			ExecuteDynamicTests(file, _analysisTestVariant);
+		}
+	}
+
+	public partial class LtsMinPluginTests
+	{
+		[Theory, MemberData(nameof(DiscoverTests), "Analysis/LtsMinPlugin")]
+		public void LtsMinPlugin(string test, string file)
+		{
+			ExecuteDynamicTests(file);
+		}
 	}
 
 	public partial class LtlTests
@@ -0,0 +1,103 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace Tests.StateAccess
+{
+	using ISSE.SafetyChecking.Modeling;
+	using SafetySharp.Modeling;
+	using Shouldly;
+
+	internal class FaultEffects : StateAccessTestObject
+	{
+		protected override void Check()
+		{
+			// Without faults, Y and W are not accessed; F1 and F2 additionally access Y, whereas F3 additionally accesses W
+			CheckTransitionGroups(new C()).ShouldBeGreaterThan(0);
+		}
+
+		private class C : Component
+		{
+			public readonly Fault F1 = new TransientFault();
+			public readonly Fault F2 = new TransientFault();
+			public readonly Fault F3 = new TransientFault();
+
+			[Range(0, 3, OverflowBehavior.Clamp)]
+			public int X;
+
+			[Range(0, 3, OverflowBehavior.WrapClamp)]
+			public int Y;
+
+			[Range(0, 3, OverflowBehavior.WrapClamp)]
+			public int Z;
+
+			[Range(0, 1, OverflowBehavior.WrapClamp)]
+			public int W;
+
+			public bool B;
+
+			public virtual int Input => 0;
+
+			public virtual void Step()
+			{
+			}
+
+			public virtual void Toggle()
+			{
+			}
+
+			public override void Update()
+			{
+				X = Input;
+				Step();
+				Toggle();
+
+				if (B)
+					Z = Z + 1;
+
+				B = Choose(true, false);
+			}
+
+			[FaultEffect(Fault = nameof(F1))]
+			internal class E1 : C
+			{
+				public override int Input => Y;
+			}
+
+			[FaultEffect(Fault = nameof(F2))]
+			internal class E2 : C
+			{
+				public override void Step()
+				{
+					Y = Y + 1;
+				}
+			}
+
+			[FaultEffect(Fault = nameof(F3))]
+			internal class E3 : C
+			{
+				public override void Toggle()
+				{
+					W = W + 1;
+				}
+			}
+		}
+	}
+}
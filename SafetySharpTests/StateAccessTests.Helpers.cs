@@ -0,0 +1,232 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace Tests
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Linq;
+	using ISSE.SafetyChecking;
+	using ISSE.SafetyChecking.AnalysisModel;
+	using ISSE.SafetyChecking.ExecutedModel;
+	using ISSE.SafetyChecking.FaultMinimalKripkeStructure;
+	using JetBrains.Annotations;
+	using SafetySharp.Analysis;
+	using SafetySharp.Modeling;
+	using SafetySharp.Runtime;
+	using Shouldly;
+	using Utilities;
+	using Xunit.Abstractions;
+
+	public abstract unsafe class StateAccessTestObject : TestObject
+	{
+		/// <summary>
+		///   Checks the state slots determined by the <see cref="StateAccessAnalysis" /> for the transition groups exported by the
+		///   LtsMin plugin against the actual behavior of the model consisting of the <paramref name="components" />: For all
+		///   pairs of reachable states, the successors of a group must not change when the slots the group neither reads nor writes
+		///   are taken from the other state, and these slots must not be changed by any of the group's transitions. Returns the
+		///   number of checked states that actually differ from the original states.
+		/// </summary>
+		protected int CheckTransitionGroups(params IComponent[] components)
+		{
+			var modelCreator = SafetySharpRuntimeModel.CreateExecutedModelCreator(TestModel.InitializeModel(components), new ExecutableStateFormula(() => true));
+
+			var configuration = AnalysisConfiguration.Default;
+			configuration.ModelCapacity = ModelCapacityByMemorySize.Small;
+			configuration.DefaultTraceOutput = Output.TextWriterAdapter();
+
+			var checkedStates = 0;
+			var models = new Func<ExecutedModel<SafetySharpRuntimeModel>>[]
+			{
+				() => new DistinctTargetExecutedModel<SafetySharpRuntimeModel>(modelCreator, 0, new Func<bool>[0], configuration),
+				() => new ActivationMinimalExecutedModel<SafetySharpRuntimeModel>(modelCreator, 0, new Func<bool>[0], configuration)
+			};
+
+			foreach (var createModel in models)
+			{
+				using (var model = createModel())
+					checkedStates += CheckTransitionGroups(model);
+			}
+
+			return checkedStates;
+		}
+
+		private int CheckTransitionGroups(ExecutedModel<SafetySharpRuntimeModel> model)
+		{
+			var runtimeModel = model.RuntimeModel;
+			var analysis = new StateAccessAnalysis(runtimeModel);
+			var states = GetReachableStates(model);
+			var checkedStates = 0;
+
+			Output.Log("States: {0}", states.Count);
+
+			// The LtsMin plugin exports one group for the transitions activating no faults, one group for each nondeterministic
+			// fault, and one group for all transitions activating more than one fault
+			var faults = runtimeModel.NondeterministicFaults;
+			var groups = new List<FaultSet> { new FaultSet() };
+			groups.AddRange(faults.Select(fault => new FaultSet(fault)));
+
+			if (faults.Length > 1)
+				groups.Add(new FaultSet(faults));
+
+			foreach (var group in groups)
+			{
+				var accesses = analysis.AnalyzeStep(group);
+				accesses.IsComplete.ShouldBe(true);
+
+				var mask = GetAccessedBits(runtimeModel, accesses);
+				var groupClass = GetFaultClass(group);
+
+				for (var i = 0; i < states.Count; ++i)
+				{
+					var expected = GetSuccessors(model, states[i], groupClass, mask);
+
+					for (var j = 1; j <= 3; ++j)
+					{
+						var state = Combine(states[i], states[(i + j) % states.Count], mask);
+						if (!state.SequenceEqual(states[i]))
+							++checkedStates;
+
+						var actual = GetSuccessors(model, state, groupClass, mask);
+						actual.SetEquals(expected).ShouldBe(true, $"Unexpected successors of group {group}.");
+					}
+				}
+			}
+
+			return checkedStates;
+		}
+
+		private static List<byte[]> GetReachableStates(ExecutedModel<SafetySharpRuntimeModel> model)
+		{
+			var states = new List<byte[]>();
+			var knownStates = new HashSet<string>();
+
+			AddTargetStates(model, model.GetInitialTransitions(), states, knownStates);
+			for (var i = 0; i < states.Count; ++i)
+			{
+				fixed (byte* state = states[i])
+					AddTargetStates(model, model.GetSuccessorTransitions(state), states, knownStates);
+			}
+
+			return states;
+		}
+
+		private static void AddTargetStates(ExecutedModel<SafetySharpRuntimeModel> model, TransitionCollection transitions,
+											List<byte[]> states, HashSet<string> knownStates)
+		{
+			foreach (CandidateTransition* transition in transitions)
+			{
+				var state = ToArray(transition->TargetStatePointer, model.ModelStateVectorSize);
+				if (knownStates.Add(Convert.ToBase64String(state)))
+					states.Add(state);
+			}
+		}
+
+		/// <summary>
+		///   Gets the successors of the <paramref name="state" /> generated by the transitions of the group identified by
+		///   <paramref name="groupClass" />, projected to the accessed bits of the state vector. The bits that are not accessed
+		///   must not be changed by the group's transitions.
+		/// </summary>
+		private static HashSet<string> GetSuccessors(ExecutedModel<SafetySharpRuntimeModel> model, byte[] state, long groupClass, byte[] mask)
+		{
+			var successors = new HashSet<string>();
+
+			fixed (byte* source = state)
+			{
+				foreach (CandidateTransition* transition in model.GetSuccessorTransitions(source))
+				{
+					if (GetFaultClass(transition->ActivatedFaults) != groupClass)
+						continue;
+
+					var target = ToArray(transition->TargetStatePointer, model.ModelStateVectorSize);
+					for (var i = 0; i < target.Length; ++i)
+						(target[i] & ~mask[i]).ShouldBe(state[i] & ~mask[i], "Transition changed a slot that is not accessed.");
+
+					successors.Add(Convert.ToBase64String(target.Select((value, i) => (byte)(value & mask[i])).ToArray()));
+				}
+			}
+
+			return successors;
+		}
+
+		/// <summary>
+		///   Gets a state that has the <paramref name="mask" />ed bits of <paramref name="state" /> and all other bits of
+		///   <paramref name="other" />.
+		/// </summary>
+		private static byte[] Combine(byte[] state, byte[] other, byte[] mask)
+		{
+			return state.Select((value, i) => (byte)((value & mask[i]) | (other[i] & ~mask[i]))).ToArray();
+		}
+
+		/// <summary>
+		///   Gets a mask of the state vector bits belonging to the slots that are read or written according to the
+		///   <paramref name="accesses" />.
+		/// </summary>
+		private static byte[] GetAccessedBits(SafetySharpRuntimeModel runtimeModel, StateAccessSet accesses)
+		{
+			var layout = runtimeModel.StateVectorLayout;
+			var offsets = layout.GetSlotOffsetsInBits();
+			var mask = new byte[runtimeModel.StateVectorSize];
+
+			for (var slot = 0; slot < layout.SlotCount; ++slot)
+			{
+				if (!accesses.IsRead(slot) && !accesses.IsWritten(slot))
+					continue;
+
+				for (var bit = offsets[slot]; bit < offsets[slot] + layout[slot].TotalSizeInBits; ++bit)
+					mask[bit / 8] |= (byte)(1 << (bit % 8));
+			}
+
+			return mask;
+		}
+
+		/// <summary>
+		///   Gets the transition group of the LtsMin plugin the transitions activating the <paramref name="faults" /> belong to.
+		/// </summary>
+		private static long GetFaultClass(FaultSet faults)
+		{
+			return (faults._faults & (faults._faults - 1)) == 0 ? faults._faults : -1;
+		}
+
+		private static byte[] ToArray(byte* state, int size)
+		{
+			var array = new byte[size];
+			for (var i = 0; i < size; ++i)
+				array[i] = state[i];
+
+			return array;
+		}
+	}
+
+	public partial class StateAccessTests : Tests
+	{
+		public StateAccessTests(ITestOutputHelper output)
+			: base(output)
+		{
+		}
+
+		[UsedImplicitly]
+		public static IEnumerable<object[]> DiscoverTests(string directory)
+		{
+			return EnumerateTestCases(GetAbsoluteTestsDirectory(directory));
+		}
+	}
+}
@@ -53,7 +53,8 @@ extern "C"
 
 HMODULE GetLtsMinExecutable() 
 {
-	static HMODULE executable = LoadLibrary(L"pins2lts-seq.exe");
+	// The plugin is loaded by the LTSmin tool that is running, i.e., pins2lts-seq or pins2lts-mc
+	static HMODULE executable = GetModuleHandle(nullptr);
 	return executable;
 }
 
@@ -210,4 +211,40 @@ void GBsetInitialState(grey_box_model* p1, int* p2)
 {
 	FUNC(GBsetInitialState);
 	func(p1, p2);
-}
\ No newline at end of file
+}
+
+void GBsetStateLabelsAll(grey_box_model* p1, void (*p2)(grey_box_model*, int*, int*))
+{
+	FUNC(GBsetStateLabelsAll);
+	func(p1, p2);
+}
+
+void GBsetStateLabelsGroup(grey_box_model* p1, void (*p2)(grey_box_model*, sl_group_enum_t, int*, int*))
+{
+	FUNC(GBsetStateLabelsGroup);
+	func(p1, p2);
+}
+
+void lts_type_set_range(lts_type_s* p1, int p2, int p3, int p4)
+{
+	FUNC(lts_type_set_range);
+	func(p1, p2, p3, p4);
+}
+
+void lts_type_set_edge_label_count(lts_type_s* p1, int p2)
+{
+	FUNC(lts_type_set_edge_label_count);
+	func(p1, p2);
+}
+
+void lts_type_set_edge_label_name(lts_type_s* p1, int p2, char const* p3)
+{
+	FUNC(lts_type_set_edge_label_name);
+	func(p1, p2, p3);
+}
+
+void lts_type_set_edge_label_typeno(lts_type_s* p1, int p2, int p3)
+{
+	FUNC(lts_type_set_edge_label_typeno);
+	func(p1, p2, p3);
+}
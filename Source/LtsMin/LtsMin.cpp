@@ -27,6 +27,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <intrin.h>
 
 //---------------------------------------------------------------------------------------------------------------------------
 // LtsMin includes
@@ -45,9 +46,18 @@ extern "C"
 	#pragma warning(pop)
 }
 
+//---------------------------------------------------------------------------------------------------------------------------
+// Plugin includes
+//---------------------------------------------------------------------------------------------------------------------------
+#include "StateLabelCache.h"
+#include "StateLabelEvaluator.h"
+#include "TargetStateTable.h"
+#include "VariableStateLayout.h"
+
 //---------------------------------------------------------------------------------------------------------------------------
 // S# includes
 //---------------------------------------------------------------------------------------------------------------------------
+#using <System.Core.dll>
 #using "SafetySharp.Modeling.dll" as_friend
 #using "ISSE.SafetyChecking.dll" as_friend
 
@@ -56,7 +66,9 @@ extern "C"
 // Namespace imports
 //---------------------------------------------------------------------------------------------------------------------------
 using namespace System;
+using namespace System::Collections::Generic;
 using namespace System::IO;
+using namespace System::IO::MemoryMappedFiles;
 using namespace System::Reflection;
 using namespace System::Runtime::InteropServices;
 using namespace System::Threading;
@@ -68,6 +80,7 @@ using namespace ISSE::SafetyChecking::ExecutableModel;
 using namespace ISSE::SafetyChecking::ExecutedModel;
 using namespace ISSE::SafetyChecking::AnalysisModel;
 using namespace ISSE::SafetyChecking::FaultMinimalKripkeStructure;
+using namespace ISSE::SafetyChecking::Modeling;
 
 //---------------------------------------------------------------------------------------------------------------------------
 // Assembly metadata
@@ -83,106 +96,566 @@ using namespace ISSE::SafetyChecking::FaultMinimalKripkeStructure;
 //---------------------------------------------------------------------------------------------------------------------------
 // Forward declarations
 //---------------------------------------------------------------------------------------------------------------------------
+ref class Worker;
 void PrepareLoadModel(model_t model, const char* file);
 void LoadModel(model_t model, const char* file);
 int32_t NextStatesCallback(model_t model, int32_t group, int32_t* state, TransitionCB callback, void* context);
 int32_t StateLabelCallback(model_t model, int32_t label, int32_t* state);
+void StateLabelsAllCallback(model_t model, int32_t* state, int32_t* labels);
+void StateLabelsGroupCallback(model_t model, sl_group_enum_t group, int32_t* state, int32_t* labels);
+uint32_t EvaluateStateLabels(Worker^ worker, int32_t* state);
+int32_t EvaluateStateLabel(Worker^ worker, int32_t label, unsigned char* state);
+array<array<int32_t>^>^ CompileStateLabels(array<array<int32_t>^>^ programs);
+void DetermineTransitionGroups();
+array<StateAccessSet^>^ AnalyzeTransitionGroups(StateAccessAnalysis^ analysis);
+array<StateAccessSet^>^ AnalyzeStateLabels(StateAccessAnalysis^ analysis);
+array<StateVariable^>^ OrderStateVariables(array<StateVariable^>^ variables, array<StateAccessSet^>^ groupAccesses, array<StateAccessSet^>^ labelAccesses);
+void InitializeTransitionGroups(int32_t stateSlotCount, array<StateAccessSet^>^ groupAccesses);
+void InitializeStateLabelMatrix(int32_t stateSlotCount, array<StateAccessSet^>^ labelAccesses);
+array<bool>^ GetReadSlots(StateAccessSet^ accesses);
+array<bool>^ GetWrittenSlots(StateAccessSet^ accesses);
+int32_t GetTransitionGroup(CandidateTransition* transition);
+void RemoveDuplicateInitialStates(Worker^ worker);
+void LoadInitialStates(RuntimeModelSerializer^ serializer);
+void RestoreInitialStates(LtsMinModelArtifacts^ artifacts);
+void SaveArtifacts(String^ key, array<array<int32_t>^>^ labelPrograms, array<StateAccessSet^>^ groupAccesses, array<StateAccessSet^>^ labelAccesses);
+int32_t EmitInitialStates(Worker^ worker, TransitionCB callback, void* context);
+void CheckInvariants(Worker^ worker, unsigned char* state);
 bool IsConstructionState(int32_t* state);
+Worker^ GetWorker();
+int32_t PutVariableType(lts_type_t ltsType, StateVariable^ variable);
+void PutEnumerationValues(model_t model, lts_type_t ltsType);
 Assembly^ OnAssemblyResolve(Object^ o, ResolveEventArgs^ e);
 
 //---------------------------------------------------------------------------------------------------------------------------
 // Global variables
 //---------------------------------------------------------------------------------------------------------------------------
+// LTSmin supports a single initial state only; the initial states of the model are therefore computed when the model is
+// loaded and, if there is more than one, a pseudo initial state is exported that leads to all of them. That state is marked by
+// a state header slot which is 0 in all other states, so the header is only present for models with multiple initial states.
+int32_t StateHeaderBytes;
+unsigned char* InitialStates;
+int32_t InitialStateCount;
+
+// The Boolean state label that only holds in the pseudo initial state, if any; it follows the labels of the model's formulas.
+int32_t InitialChoiceLabel;
+
+// The labels whose formulas can be compiled are evaluated directly on the packed state vectors by an evaluator shared by all
+// workers; all other labels are evaluated by the managed formulas on the deserialized model.
+StateLabelEvaluator* LabelEvaluator;
+
+// The indices of the labels evaluated by the managed formulas and, for each label, the bit its value is stored in by the
+// workers' label caches, or -1 if the label is evaluated natively and therefore never cached.
+int32_t ManagedLabelCount;
+int32_t* ManagedLabels;
+int32_t* LabelCacheBits;
+
+// By default, LTSmin operates on the bit-packed state vectors of S#, split into 32 bit words; optionally, each state
+// variable is exported as a slot of its own, in which case the state vectors are converted at the PINS boundary.
+int32_t UseVariableLayout = 0;
+VariableStateLayout* VariableLayout;
+int32_t StateSlotCount;
+
+// Optionally, the nondeterministic faults activated by a transition are exported as Boolean edge labels, one per fault;
+// otherwise, transitions leading to the same target state are merged.
+int32_t UseFaultLabels = 0;
+int32_t FaultLabelCount;
+uint64_t FaultLabelMasks[64];
+
+// Optionally, details about the loaded model and its preparation are reported, such as the size of the state vector; the
+// diagnostics explaining why the plugin falls back to a slower mode of operation are always reported.
+int32_t ReportModelDetails = 0;
+
+// The number of successor states each worker's buffers are initially allocated for and the number of successor states the
+// buffers may grow to on demand; the buffers are doubled whenever the successors of a state do not fit into them.
+int32_t InitialSuccessorCapacity = 1 << 10;
+int32_t MaximumSuccessorCapacity = 1 << 30;
+
+// Optionally, all state formulas of the model are checked as invariants during a single exploration of the state space that
+// does not check any LTSmin property; the indices of the violated formulas are written to the given file.
+char* InvariantsFile = nullptr;
+int32_t InvariantCount;
+volatile int32_t ViolatedInvariantCount;
+volatile int32_t* InvariantViolations;
+
+// Optionally, only the state formulas with the given comma-separated indices are checked as invariants. The exploration stops
+// once all checked invariants are known to be violated; formulas that are not state formulas are never checked.
+char* InvariantIndices = nullptr;
+bool* CheckedInvariants;
+int32_t CheckedInvariantCount;
+
+// Optionally, the initial states, the compiled state labels, and the state accesses of the transition groups and state labels
+// are cached in the given directory, so that they only have to be computed by the first LTSmin run for a model.
+char* ArtifactsDirectory = nullptr;
+
 matrix_t CombinedMatrix;
 matrix_t ReadMatrix;
 matrix_t WriteMatrix;
 matrix_t StateLabelMatrix;
 
+// Transitions are grouped by the nondeterministic faults they activate: The initial transitions leaving the pseudo initial
+// state, if any, form a group of their own, followed by the group of transitions that do not activate any faults, one group
+// for each fault that is activated exclusively, and one group for all transitions that activate more than one fault.
+int32_t ConstructionGroup;
+int32_t NoFaultsGroup;
+int32_t MultipleFaultsGroup;
+int32_t TransitionGroupCount;
+int32_t FaultGroups[64];
+
+// Synchronizes model loading and worker creation, as the multi-core LTSmin tools load the model on each worker thread. Kept
+// separate from the globals as it is used before the S# assemblies can be resolved.
+ref struct Synchronization
+{
+	static Object^ Lock = gcnew Object();
+	static bool IsAssemblyResolverRegistered;
+};
+
 // Global variables of managed types must be wrapped in a class...
 ref struct Globals
 {
-	static ActivationMinimalExecutedModel<SafetySharpRuntimeModel^>^ ExecutedModel;
+	// The memory-mapped model file, the serializer all model instances are deserialized with, and the model instance that is
+	// deserialized when the model is loaded; the latter only provides the model's metadata and is never executed, as each
+	// worker thread executes its own model instance.
+	static MemoryMappedFile^ MappedModelFile;
+	static RuntimeModelSerializer^ Serializer;
 	static StateVectorLayout^ StateVectorLayout;
 	static SafetySharpRuntimeModel^ RuntimeModel;
 	static LtsMin^ LtsMin;
+	static LtsMinModelSettings^ Settings;
 	static const char* ModelFile;
+	static array<StateVariable^>^ StateVariables;
+
+	// The worker of the current thread, if the thread has already invoked any of the callbacks.
+	[ThreadStatic]
+	static Worker^ CurrentWorker;
 };
 
+//---------------------------------------------------------------------------------------------------------------------------
+// Workers
+//---------------------------------------------------------------------------------------------------------------------------
+
+// Provides the model instances and buffers used by a single LTSmin worker thread. The executed model, the runtime model
+// it executes, and the transitions it generates must not be shared between threads.
+ref class Worker
+{
+public:
+	Worker(RuntimeModelSerializer^ serializer, int32_t stateHeaderBytes)
+	{
+		RuntimeModel = gcnew SafetySharpRuntimeModel(serializer->Load(), stateHeaderBytes);
+		Globals::Settings->Apply(RuntimeModel);
+
+		auto configuration = Globals::Settings->Apply(AnalysisConfiguration::Default);
+		configuration.SuccessorCapacity = MaximumSuccessorCapacity;
+		configuration.InitialSuccessorCapacity = InitialSuccessorCapacity;
+
+		// The executed model evaluates the managed state labels for all target states it computes; we cache these values to
+		// answer LTSmin's label queries without having to deserialize the states again. Natively evaluated labels are cheaper
+		// to recompute than to look up in the cache, so they are not evaluated by the executed model at all. The cache stores
+		// the values of a state's labels as a 32 bit mask; for models with 32 or more managed labels, the cache is disabled
+		// and all labels are evaluated on demand.
+		auto labelFormulas = gcnew array<Func<bool>^>(ManagedLabelCount < 32 ? ManagedLabelCount : 0);
+		for (auto i = 0; i < labelFormulas->Length; ++i)
+			labelFormulas[i] = RuntimeModel->ExecutableStateFormulas[ManagedLabels[i]]->Expression;
+
+		// The activated faults only have to be tracked precisely when they are exported as edge labels; otherwise, it suffices to
+		// compute the distinct target states, which is considerably cheaper for models with many faults
+		auto modelCreator = CreateModelCreator();
+		if (UseFaultLabels)
+			ExecutedModel = gcnew ActivationMinimalExecutedModel<SafetySharpRuntimeModel^>(modelCreator, stateHeaderBytes, labelFormulas, configuration);
+		else
+			ExecutedModel = gcnew DistinctTargetExecutedModel<SafetySharpRuntimeModel^>(modelCreator, stateHeaderBytes, labelFormulas, configuration);
+
+		if (labelFormulas->Length > 0)
+			LabelCache = new StateLabelCache(RuntimeModel->StateVectorSize);
+
+		MemoizedState = (unsigned char*)malloc(RuntimeModel->StateVectorSize);
+		HasMemoizedTransitions = false;
+
+		DeserializedState = (unsigned char*)malloc(RuntimeModel->StateVectorSize);
+		HasDeserializedState = false;
+		ExecutedModel->RuntimeModelStateChanged += gcnew Action(this, &Worker::InvalidateDeserializedState);
+		Transitions = nullptr;
+		TransitionCapacity = 0;
+		TargetStates = new TargetStateTable(RuntimeModel->StateVectorSize);
+
+		if (FaultLabelCount > 0)
+			EdgeLabels = (int32_t*)malloc(FaultLabelCount * sizeof(int32_t));
+
+		if (VariableLayout != nullptr)
+		{
+			PackedState = (unsigned char*)malloc(RuntimeModel->StateVectorSize);
+			UnpackedState = (int32_t*)malloc(StateSlotCount * sizeof(int32_t));
+		}
+
+		if (InvariantViolations != nullptr)
+		{
+			Invariants = gcnew array<Func<bool>^>(InvariantCount);
+			for (auto i = 0; i < InvariantCount; ++i)
+			{
+				if (CheckedInvariants[i])
+					Invariants[i] = ISSE::SafetyChecking::Formula::FormulaEvaluationExtension::Compile(RuntimeModel, RuntimeModel->Formulas[i]);
+			}
+		}
+	}
+
+	// Stores pointers to the valid transitions of the given collection in the transitions buffer.
+	void SetTransitions(TransitionCollection transitions)
+	{
+		if (transitions.Count > TransitionCapacity)
+		{
+			auto buffer = (CandidateTransition**)realloc(Transitions, transitions.Count * sizeof(CandidateTransition*));
+			if (buffer == nullptr)
+				throw gcnew OutOfMemoryException("Unable to allocate the transitions buffer.");
+
+			Transitions = buffer;
+			TransitionCapacity = transitions.Count;
+		}
+
+		TransitionCount = transitions.GetValidTransitions((Transition**)Transitions);
+	}
+
+	// Deserializes the given state into the runtime model, unless the model is known to already be in that state.
+	void Deserialize(unsigned char* state)
+	{
+		if (IsDeserialized(state))
+			return;
+
+		RuntimeModel->Deserialize(state);
+		memcpy(DeserializedState, state, RuntimeModel->StateVectorSize);
+		HasDeserializedState = true;
+	}
+
+	// Checks whether the runtime model has been deserialized from the given state and has not been changed since.
+	bool IsDeserialized(unsigned char* state)
+	{
+		return HasDeserializedState && memcmp(DeserializedState, state, RuntimeModel->StateVectorSize) == 0;
+	}
+
+	// Gets the bit-packed representation of the state vector passed in by LTSmin.
+	unsigned char* GetPackedState(int32_t* state)
+	{
+		if (VariableLayout == nullptr)
+			return (unsigned char*)state;
+
+		VariableLayout->Pack(state, PackedState);
+		return PackedState;
+	}
+
+	// Gets the representation of the bit-packed state vector passed out to LTSmin.
+	int32_t* GetExportedState(unsigned char* packedState)
+	{
+		if (VariableLayout == nullptr)
+			return (int32_t*)packedState;
+
+		VariableLayout->Unpack(packedState, UnpackedState);
+		return UnpackedState;
+	}
+
+	ISSE::SafetyChecking::ExecutedModel::ExecutedModel<SafetySharpRuntimeModel^>^ ExecutedModel;
+	SafetySharpRuntimeModel^ RuntimeModel;
+	StateLabelCache* LabelCache;
+
+	// LTSmin requests the successors of a state separately for each group; the transitions of the last state whose successors
+	// were computed are therefore reused until the successors of a different state are requested. Only pointers to the valid
+	// transitions are kept so that they can be emitted without going through the managed transition enumerator.
+	CandidateTransition** Transitions;
+	int32_t TransitionCount;
+	int32_t TransitionCapacity;
+	unsigned char* MemoizedState;
+	bool HasMemoizedTransitions;
+
+	// LTSmin typically queries the labels of a state right before or after expanding it, often one label at a time; the state
+	// the runtime model was last deserialized from is therefore remembered so that repeated deserializations of the same state
+	// can be skipped. The executed model invalidates the memo whenever the execution of a step changes the runtime model.
+	unsigned char* DeserializedState;
+	bool HasDeserializedState;
+
+	// The distinct target states of the memoized transitions.
+	TargetStateTable* TargetStates;
+
+	// The buffer for the edge labels of the emitted transitions, if any.
+	int32_t* EdgeLabels;
+
+	// The compiled invariants that are checked for all states, if any.
+	array<Func<bool>^>^ Invariants;
+
+	// The buffers used to convert state vectors when the variable layout is used.
+	unsigned char* PackedState;
+	int32_t* UnpackedState;
+
+private:
+	void InvalidateDeserializedState()
+	{
+		HasDeserializedState = false;
+	}
+
+	SafetySharpRuntimeModel^ CreateModel(int dummyStateHeaderBytes)
+	{
+		// dummyStateHeaderBytes are just ignored
+		return RuntimeModel;
+	}
+
+	static void WriteFullStateVectorLayout(TextWriter^ textWriter)
+	{
+		textWriter->WriteLine(Globals::StateVectorLayout);
+	}
+
+	CoupledExecutableModelCreator<SafetySharpRuntimeModel^>^ CreateModelCreator()
+	{
+		auto createModelFunc = gcnew Func<int, SafetySharpRuntimeModel^>(this, &Worker::CreateModel);
+		auto writeFullStateVectorLayout = gcnew Action<TextWriter^>(&Worker::WriteFullStateVectorLayout);
+		auto model = RuntimeModel->Model;
+		auto formulas = RuntimeModel->Formulas;
+		auto faults = RuntimeModel->Faults;
+		auto creator = gcnew CoupledExecutableModelCreator<SafetySharpRuntimeModel^>(createModelFunc, writeFullStateVectorLayout, model, formulas, faults);
+		return creator;
+	}
+};
+
+Worker^ GetWorker()
+{
+	// Workers are created lazily on the first callback invoked by a thread
+	auto worker = Globals::CurrentWorker;
+	if (worker != nullptr)
+		return worker;
+
+	Monitor::Enter(Synchronization::Lock);
+	try
+	{
+		worker = gcnew Worker(Globals::Serializer, StateHeaderBytes);
+	}
+	finally
+	{
+		Monitor::Exit(Synchronization::Lock);
+	}
+
+	Globals::CurrentWorker = worker;
+	return worker;
+}
+
 //---------------------------------------------------------------------------------------------------------------------------
 // PINS exports
 //---------------------------------------------------------------------------------------------------------------------------
 extern "C" __declspec(dllexport) char pins_plugin_name[] = "S# Model";
 extern "C" __declspec(dllexport) loader_record pins_loaders[] = { { "ssharp", PrepareLoadModel },{ nullptr, nullptr } };
-extern "C" __declspec(dllexport) void* pins_options[] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
+
+// The layout of the entries of popt's option tables, which LTSmin uses to parse its command line; popt's headers are not
+// part of the LTSmin headers, so the structure is declared here.
+struct poptOption
+{
+	const char* longName;
+	char shortName;
+	unsigned int argInfo;
+	void* arg;
+	int val;
+	const char* descrip;
+	const char* argDescrip;
+};
+
+// Corresponds to popt's POPT_ARG_STRING, POPT_ARG_INT, and POPT_ARG_VAL, i.e., the option either takes a string or integer
+// argument that is stored in arg or does not take an argument and stores val in arg when it is set
+const unsigned int PoptArgumentString = 1;
+const unsigned int PoptArgumentInt = 2;
+const unsigned int PoptArgumentValue = 7;
+
+extern "C" __declspec(dllexport) poptOption pins_options[] =
+{
+	{ "ssharp-variable-layout", 0, PoptArgumentValue, &UseVariableLayout, 1, "export one state slot for each state variable instead of the bit-packed state vector", nullptr },
+	{ "ssharp-fault-labels", 0, PoptArgumentValue, &UseFaultLabels, 1, "export the faults activated by transitions as edge labels", nullptr },
+	{ "ssharp-verbose", 0, PoptArgumentValue, &ReportModelDetails, 1, "report details about the loaded model and its preparation", nullptr },
+	{ "ssharp-invariants", 0, PoptArgumentString, &InvariantsFile, 0, "check all state formulas as invariants and write the indices of the violated ones to the given file", "<file>" },
+	{ "ssharp-invariant-indices", 0, PoptArgumentString, &InvariantIndices, 0, "only check the state formulas with the given comma-separated indices as invariants", "<indices>" },
+	{ "ssharp-initial-successors", 0, PoptArgumentInt, &InitialSuccessorCapacity, 0, "the number of successor states the buffers of each worker are initially allocated for", "<count>" },
+	{ "ssharp-max-successors", 0, PoptArgumentInt, &MaximumSuccessorCapacity, 0, "the maximum number of successor states that can be computed for a single state", "<count>" },
+	{ "ssharp-artifacts", 0, PoptArgumentString, &ArtifactsDirectory, 0, "cache the results of the model preparations in the given directory and reuse them for the same model", "<directory>" },
+	{ nullptr, 0, 0, nullptr, 0, nullptr, nullptr }
+};
 
 //---------------------------------------------------------------------------------------------------------------------------
 // S# model loading
 //---------------------------------------------------------------------------------------------------------------------------
 void PrepareLoadModel(model_t model, const char* modelFile)
 {
-	AppDomain::CurrentDomain->AssemblyResolve += gcnew System::ResolveEventHandler(&OnAssemblyResolve);
-	LoadModel(model, modelFile);
-}
+	// Models are loaded one at a time; among other things, the function pointers into the LTSmin executable are initialized
+	// lazily and must not be initialized concurrently
+	Monitor::Enter(Synchronization::Lock);
+	try
+	{
+		if (!Synchronization::IsAssemblyResolverRegistered)
+			AppDomain::CurrentDomain->AssemblyResolve += gcnew System::ResolveEventHandler(&OnAssemblyResolve);
 
-SafetySharpRuntimeModel^ CreateModel(int dummyStateHeaderBytes)
-{
-	// dummyStateHeaderBytes are just ignored
-	return Globals::RuntimeModel;
+		Synchronization::IsAssemblyResolverRegistered = true;
+		LoadModel(model, modelFile);
+	}
+	finally
+	{
+		Monitor::Exit(Synchronization::Lock);
+	}
 }
 
-void WriteFullStateVectorLayout(TextWriter^ textWriter)
+void LoadSharedModelData(const char* modelFile)
 {
-	textWriter->WriteLine(Globals::StateVectorLayout);
-}
+	// The model's metadata and the dependency matrices are shared by all workers, so they are only computed once
+	if (Globals::Serializer != nullptr)
+		return;
 
-CoupledExecutableModelCreator<SafetySharpRuntimeModel^>^ CreateModelCreator()
-{
-	auto createModelFunc = gcnew Func<int,SafetySharpRuntimeModel^>(&CreateModel);
-	auto writeFullStateVectorLayout = gcnew Action<TextWriter^>(&WriteFullStateVectorLayout);
-	auto model = Globals::RuntimeModel->Model;
-	auto formulas = Globals::RuntimeModel->Formulas;
-	auto faults = Globals::RuntimeModel->Faults;
-	auto creator = gcnew CoupledExecutableModelCreator<SafetySharpRuntimeModel^>(createModelFunc, writeFullStateVectorLayout, model, formulas, faults);
-	return creator;
-}
+	// The model file is mapped into memory instead of being read into the managed heap; all model instances are deserialized
+	// directly from the mapped pages by the same serializer, so that the deserialization code is only generated once
+	auto mappedModelFile = MemoryMappedFile::CreateFromFile(gcnew String(modelFile), FileMode::Open, nullptr, 0, MemoryMappedFileAccess::Read);
+	auto serializer = RuntimeModelSerializer::LoadSerializedData(mappedModelFile);
+
+	// The analysis settings follow the serialized model; they restrict the fault activations of all model instances
+	Globals::Settings = LtsMinModelSettings::Load(gcnew String(modelFile));
+	auto serializedModel = serializer->Load();
+
+	// The initial states, the compiled state labels, and the state accesses only depend on the model file and the assemblies
+	// the model is loaded from; if they have been cached by a previous LTSmin run for the same model, they are reused
+	String^ artifactsKey = nullptr;
+	LtsMinModelArtifacts^ artifacts = nullptr;
+	if (ArtifactsDirectory != nullptr)
+	{
+		artifactsKey = LtsMinModelArtifacts::ComputeKey(gcnew String(modelFile), serializedModel.ObjectTable);
+		artifacts = LtsMinModelArtifacts::Load(gcnew String(ArtifactsDirectory), artifactsKey, serializer->StateVector);
+
+		if (artifacts != nullptr && ReportModelDetails)
+			Console::WriteLine("Reusing the cached model artifacts.");
+	}
+
+	if (artifacts != nullptr)
+		RestoreInitialStates(artifacts);
+	else
+		LoadInitialStates(serializer);
+
+	Globals::RuntimeModel = gcnew SafetySharpRuntimeModel(serializedModel, StateHeaderBytes);
+	Globals::Settings->Apply(Globals::RuntimeModel);
+	Globals::StateVectorLayout = serializer->StateVector;
+	StateSlotCount = (int32_t)(Globals::RuntimeModel->StateVectorSize / sizeof(int32_t));
+	auto labelPrograms = CompileStateLabels(artifacts != nullptr ? artifacts->LabelPrograms : nullptr);
+
+	// Statically determine the state accessed by the transition groups and the state labels
+	DetermineTransitionGroups();
+
+	array<StateAccessSet^>^ groupAccesses;
+	array<StateAccessSet^>^ labelAccesses;
+	if (artifacts != nullptr)
+	{
+		groupAccesses = artifacts->GroupAccesses;
+		labelAccesses = artifacts->LabelAccesses;
+	}
+	else
+	{
+		auto analysis = gcnew StateAccessAnalysis(Globals::RuntimeModel);
+		groupAccesses = AnalyzeTransitionGroups(analysis);
+		labelAccesses = AnalyzeStateLabels(analysis);
+
+		if (artifactsKey != nullptr)
+			SaveArtifacts(artifactsKey, labelPrograms, groupAccesses, labelAccesses);
+	}
+
+	if (UseVariableLayout)
+	{
+		auto variables = Globals::RuntimeModel->StateVectorLayout->GetStateVariables(StateHeaderBytes);
+		variables = OrderStateVariables(variables, groupAccesses, labelAccesses);
+
+		Globals::StateVariables = variables;
+		StateSlotCount = variables->Length;
+		VariableLayout = new VariableStateLayout(Globals::RuntimeModel->StateVectorSize, variables->Length);
+
+		for (auto i = 0; i < variables->Length; ++i)
+			VariableLayout->SetVariable(i, variables[i]->OffsetInBits, variables[i]->SizeInBits, variables[i]->IsSigned);
+	}
+
+	if (InvariantsFile != nullptr)
+	{
+		auto formulas = Globals::RuntimeModel->Formulas;
+		InvariantCount = formulas->Length;
+		InvariantViolations = (int32_t*)calloc(InvariantCount + 1, sizeof(int32_t));
+		CheckedInvariants = (bool*)calloc(InvariantCount + 1, sizeof(bool));
+
+		if (InvariantIndices != nullptr)
+		{
+			auto indices = (gcnew String(InvariantIndices))->Split(gcnew array<Char> { ',' }, StringSplitOptions::RemoveEmptyEntries);
+			for (auto i = 0; i < indices->Length; ++i)
+				CheckedInvariants[Int32::Parse(indices[i])] = true;
+		}
+		else
+		{
+			for (auto i = 0; i < InvariantCount; ++i)
+				CheckedInvariants[i] = true;
+		}
+
+		// Formulas that are not state formulas cannot be checked as invariants and are therefore ignored
+		CheckedInvariantCount = 0;
+		for (auto i = 0; i < InvariantCount; ++i)
+		{
+			CheckedInvariants[i] = CheckedInvariants[i] && ISSE::SafetyChecking::Formula::FormulaExtensions::IsStateFormula(formulas[i]);
+			if (CheckedInvariants[i])
+				++CheckedInvariantCount;
+		}
+
+		if (ReportModelDetails)
+			Console::WriteLine("Checking {0} invariants.", CheckedInvariantCount);
+	}
+
+	if (UseFaultLabels)
+	{
+		auto faults = Globals::RuntimeModel->NondeterministicFaults;
+
+		FaultLabelCount = faults->Length;
+		for (auto i = 0; i < faults->Length; ++i)
+			FaultLabelMasks[i] = 1ull << faults[i]->Identifier;
+	}
 
+	// Create and initialize the dependency matrices
+	InitializeTransitionGroups(StateSlotCount, groupAccesses);
+	InitializeStateLabelMatrix(StateSlotCount, labelAccesses);
+
+	Globals::MappedModelFile = mappedModelFile;
+	Globals::Serializer = serializer;
+}
 
 void LoadModel(model_t model, const char* modelFile)
 {
 	try
 	{
-		int stateHeaderBytes = sizeof(int32_t);
-
-		auto serializer = RuntimeModelSerializer::LoadSerializedData(File::ReadAllBytes(gcnew String(modelFile)));
-		auto modelData = serializer->Load();
-		Globals::RuntimeModel = gcnew SafetySharpRuntimeModel(modelData, stateHeaderBytes);
-		Globals::StateVectorLayout = serializer->StateVector;
+		LoadSharedModelData(modelFile);
 
-		auto configuration = AnalysisConfiguration::Default;
-		configuration.SuccessorCapacity = 1 << 16;
+		auto stateSlotCount = StateSlotCount;
+		auto stateLabelCount = Globals::RuntimeModel->ExecutableStateFormulas->Length;
 
-		Globals::ExecutedModel = gcnew ActivationMinimalExecutedModel<SafetySharpRuntimeModel^>(CreateModelCreator(), stateHeaderBytes, gcnew array<Func<bool>^>(0), configuration);
+		if (ReportModelDetails)
+		{
+			Console::WriteLine("State Labels: "+stateLabelCount);
+			Console::WriteLine("Initial states: {0}", InitialStateCount);
+			Console::WriteLine("State vector has {0} slots ({1} bytes).", stateSlotCount, stateSlotCount * sizeof(int32_t));
 
-		auto stateSlotCount = (int32_t)(Globals::RuntimeModel->StateVectorSize / sizeof(int32_t));
-		auto stateLabelCount = Globals::RuntimeModel->ExecutableStateFormulas->Length;
-		Console::WriteLine("State Labels: "+stateLabelCount);
-		auto transitionGroupCount = 1;
+			if (VariableLayout != nullptr)
+				Console::WriteLine("Exporting one slot per state variable ({0} bytes packed).", Globals::RuntimeModel->StateVectorSize);
+		}
 
 		// Create the LTS type and set the state vector size
 		auto ltsType = lts_type_create();
 		lts_type_set_state_length(ltsType, stateSlotCount);
-		Console::WriteLine("State vector has {0} slots ({1} bytes).", stateSlotCount, stateSlotCount * sizeof(int32_t));
 
-		// Set the 'int' type for state slots and their names
+		// Set the types of the state slots and their names; the words of the bit-packed state vector are untyped, whereas state
+		// variables are exported with the types of the values they store
 		auto intType = lts_type_put_type(ltsType, "int", LTStypeDirect, nullptr);
 		for (auto i = 0; i < stateSlotCount; ++i)
 		{
-			lts_type_set_state_typeno(ltsType, i, intType);
+			// If present, slot 0 is the special slot marking the pseudo initial state
+			auto isHeaderSlot = StateHeaderBytes != 0 && i == 0;
+			auto hasVariableType = VariableLayout != nullptr && !isHeaderSlot;
+			lts_type_set_state_typeno(ltsType, i, hasVariableType ? PutVariableType(ltsType, Globals::StateVariables[i]) : intType);
 
-			// Slot 0 is the special pseudo construction slot
-			if (i == 0)
+			if (isHeaderSlot)
+			{
+				auto name = Marshal::StringToHGlobalAnsi(LtsMin::InitialChoiceSlotName);
+				lts_type_set_state_name(ltsType, i, (char*)name.ToPointer());
+				Marshal::FreeHGlobal(name);
+			}
+			else if (VariableLayout != nullptr)
 			{
-				auto name = Marshal::StringToHGlobalAnsi(LtsMin::ConstructionStateName);
+				auto name = Marshal::StringToHGlobalAnsi(Globals::StateVariables[i]->Name);
 				lts_type_set_state_name(ltsType, i, (char*)name.ToPointer());
 				Marshal::FreeHGlobal(name);
 			}
@@ -196,18 +669,39 @@ void LoadModel(model_t model, const char* modelFile)
 
 		// Create the state labels
 		auto boolType = lts_type_put_type(ltsType, LTSMIN_TYPE_BOOL, LTStypeEnum, nullptr);
-		lts_type_set_state_label_count(ltsType, stateLabelCount);
+		lts_type_set_state_label_count(ltsType, stateLabelCount + 1);
 
 		for (auto i = 0; i < stateLabelCount; ++i)
 		{
 			auto stateLabel = Marshal::StringToHGlobalAnsi(Globals::RuntimeModel->ExecutableStateFormulas[i]->Label);
 			auto name = (char*)stateLabel.ToPointer();
-			Console::WriteLine("State Label " + i + ": "+ (gcnew System::String(name)));
+			if (ReportModelDetails)
+				Console::WriteLine("State Label " + i + ": "+ (gcnew System::String(name)));
 			lts_type_set_state_label_name(ltsType, i, (char*)stateLabel.ToPointer());
 			lts_type_set_state_label_typeno(ltsType, i, boolType);
 			Marshal::FreeHGlobal(stateLabel);
 		}
 
+		auto initialChoiceLabel = Marshal::StringToHGlobalAnsi(LtsMin::InitialChoiceLabelName);
+		lts_type_set_state_label_name(ltsType, InitialChoiceLabel, (char*)initialChoiceLabel.ToPointer());
+		lts_type_set_state_label_typeno(ltsType, InitialChoiceLabel, boolType);
+		Marshal::FreeHGlobal(initialChoiceLabel);
+
+		// Create the fault edge labels
+		if (UseFaultLabels)
+		{
+			auto labelNames = LtsMin::GetFaultLabelNames(Globals::RuntimeModel->NondeterministicFaults);
+			lts_type_set_edge_label_count(ltsType, FaultLabelCount);
+
+			for (auto i = 0; i < FaultLabelCount; ++i)
+			{
+				auto name = Marshal::StringToHGlobalAnsi(labelNames[i]);
+				lts_type_set_edge_label_name(ltsType, i, (char*)name.ToPointer());
+				lts_type_set_edge_label_typeno(ltsType, i, boolType);
+				Marshal::FreeHGlobal(name);
+			}
+		}
+
 		// Finalize the LTS type and set it for the model
 		lts_type_validate(ltsType);
 		GBsetLTStype(model, ltsType);
@@ -215,38 +709,35 @@ void LoadModel(model_t model, const char* modelFile)
 		// Assign enum names
 		GBchunkPut(model, boolType, chunk_str(LTSMIN_VALUE_BOOL_FALSE));
 		GBchunkPut(model, boolType, chunk_str(LTSMIN_VALUE_BOOL_TRUE));
+
+		if (VariableLayout != nullptr)
+			PutEnumerationValues(model, ltsType);
 		
-		// Set the initial state, the user context, and the callback functions
-		pin_ptr<unsigned char> initialStatePtr = &Globals::RuntimeModel->ConstructionState[0];
-		auto initialState = (int32_t*)initialStatePtr;
-		initialState[0] = 1;
-		GBsetInitialState(model, initialState);
-		GBsetNextStateLong(model, NextStatesCallback);
-		GBsetStateLabelLong(model, StateLabelCallback);
+		// Set the initial state, the user context, and the callback functions; the pseudo initial state has the same state
+		// variable values as the first initial state, so the labels of the model's formulas are never evaluated for any
+		// state that is not actually reachable
+		auto stateVectorSize = Globals::RuntimeModel->StateVectorSize;
+		auto initialState = (int32_t*)malloc(stateVectorSize);
+		memcpy(initialState, InitialStates, stateVectorSize);
 
-		// Create the dependency matrices
-		dm_create(&CombinedMatrix, transitionGroupCount, stateSlotCount);
-		dm_create(&ReadMatrix, transitionGroupCount, stateSlotCount);
-		dm_create(&WriteMatrix, transitionGroupCount, stateSlotCount);
-		dm_create(&StateLabelMatrix, stateLabelCount, stateSlotCount);
+		if (StateHeaderBytes != 0)
+			initialState[0] = 1;
 
-		// Initialize the dependency matrices
-		for (int i = 0; i < transitionGroupCount; i++)
+		if (VariableLayout != nullptr)
 		{
-			for (int j = 0; j < stateSlotCount; j++)
-			{
-				dm_set(&CombinedMatrix, i, j);
-				dm_set(&ReadMatrix, i, j);
-				dm_set(&WriteMatrix, i, j);
-			}
+			auto packedState = initialState;
+			initialState = (int32_t*)malloc(stateSlotCount * sizeof(int32_t));
+			VariableLayout->Unpack((unsigned char*)packedState, initialState);
+			free(packedState);
 		}
 
-		// Initialize the state label matrix
-		for (int i = 0; i < stateLabelCount; i++)
-		{
-			for (int j = 0; j < stateSlotCount; j++)
-				dm_set(&StateLabelMatrix, i, j);
-		}
+		GBsetInitialState(model, initialState);
+		free(initialState);
+
+		GBsetNextStateLong(model, NextStatesCallback);
+		GBsetStateLabelLong(model, StateLabelCallback);
+		GBsetStateLabelsAll(model, StateLabelsAllCallback);
+		GBsetStateLabelsGroup(model, StateLabelsGroupCallback);
 
 		// Set the matrices
 		GBsetDMInfo(model, &CombinedMatrix);
@@ -261,28 +752,116 @@ void LoadModel(model_t model, const char* modelFile)
 	}
 }
 
+//---------------------------------------------------------------------------------------------------------------------------
+// State variable types
+//---------------------------------------------------------------------------------------------------------------------------
+int32_t PutVariableType(lts_type_t ltsType, StateVariable^ variable)
+{
+	auto format = variable->EnumerationValues != nullptr ? LTStypeEnum : variable->IsRange ? LTStypeRange : LTStypeDirect;
+	auto name = Marshal::StringToHGlobalAnsi(variable->TypeName);
+
+	int isNew;
+	auto type = lts_type_put_type(ltsType, (char*)name.ToPointer(), format, &isNew);
+	Marshal::FreeHGlobal(name);
+
+	if (isNew && variable->IsRange)
+		lts_type_set_range(ltsType, type, variable->LowerBound, variable->UpperBound);
+
+	return type;
+}
+
+void PutEnumerationValues(model_t model, lts_type_t ltsType)
+{
+	// The values of an enumeration type are numbered in the order they are added, which must match the values stored in the
+	// state variables; the names of the Boolean values have already been added at this point
+	auto types = gcnew List<String^>();
+	types->Add(LTSMIN_TYPE_BOOL);
+
+	for (auto i = 0; i < Globals::StateVariables->Length; ++i)
+	{
+		auto variable = Globals::StateVariables[i];
+		if (variable->EnumerationValues == nullptr || types->Contains(variable->TypeName))
+			continue;
+
+		types->Add(variable->TypeName);
+		auto type = PutVariableType(ltsType, variable);
+		for each (auto value in variable->EnumerationValues)
+		{
+			auto name = Marshal::StringToHGlobalAnsi(value);
+			GBchunkPut(model, type, chunk_str((char*)name.ToPointer()));
+			Marshal::FreeHGlobal(name);
+		}
+	}
+}
+
 //---------------------------------------------------------------------------------------------------------------------------
 // Next states function
 //---------------------------------------------------------------------------------------------------------------------------
 int32_t NextStatesCallback(model_t model, int32_t group, int32_t* state, TransitionCB callback, void* context)
 {
 	(void)model;
-	(void)group;
 
 	try
 	{
-		auto transitions = IsConstructionState(state)
-			? Globals::ExecutedModel->GetInitialTransitions()
-			: Globals::ExecutedModel->GetSuccessorTransitions((unsigned char*)state);
+		// The pseudo initial state only has initial transitions, all other states only have successor transitions
+		auto isConstructionState = IsConstructionState(state);
+		if (isConstructionState != (group == ConstructionGroup))
+			return 0;
+
+		// Once all checked invariants are known to be violated, no further successors are emitted to cut the exploration short
+		if (InvariantViolations != nullptr && ViolatedInvariantCount == CheckedInvariantCount)
+			return 0;
+
+		auto worker = GetWorker();
+		if (isConstructionState)
+			return EmitInitialStates(worker, callback, context);
+
+		auto packedState = worker->GetPackedState(state);
+		auto stateVectorSize = worker->RuntimeModel->StateVectorSize;
+		if (!worker->HasMemoizedTransitions || memcmp(worker->MemoizedState, packedState, stateVectorSize) != 0)
+		{
+			worker->HasMemoizedTransitions = false;
+
+			// Each reachable state is expanded, so the invariants are checked exactly once for each state
+			if (worker->Invariants != nullptr)
+				CheckInvariants(worker, packedState);
 
-		transition_info info = { nullptr, 0, 0 };
+			// Without fault labels, the executed model already generates a single transition per target state and group; if the state's
+			// labels or invariants have just been evaluated on the runtime model, the state does not have to be deserialized again
+			worker->SetTransitions(worker->ExecutedModel->GetSuccessorTransitions(packedState, worker->IsDeserialized(packedState)));
+
+			memcpy(worker->MemoizedState, packedState, stateVectorSize);
+			worker->HasMemoizedTransitions = true;
+		}
+
+		transition_info info = { worker->EdgeLabels, group, 0 };
 		auto transitionCount = 0;
+		auto labelCache = worker->LabelCache;
+		auto transitions = worker->Transitions;
 
-		for each (auto transition in transitions)
+		// The executed model clears the state header of all target states, so they can be passed to LTSmin as-is
+		for (auto t = 0; t < worker->TransitionCount; ++t)
 		{
-			auto stateMemory = (int32_t*)((CandidateTransition*)transition)->TargetStatePointer;
-			stateMemory[0] = 0;
-			callback(context, &info, stateMemory, nullptr);
+			auto candidate = transitions[t];
+			if (GetTransitionGroup(candidate) != group)
+				continue;
+
+			auto stateMemory = (int32_t*)candidate->TargetStatePointer;
+
+			if (labelCache != nullptr)
+			{
+				uint32_t labels = 0;
+				for (auto i = 0; i < ManagedLabelCount; ++i)
+					labels |= candidate->Formulas[i] ? 1u << i : 0u;
+
+				labelCache->Add(stateMemory, labels);
+			}
+
+			auto faults = (uint64_t)candidate->ActivatedFaults._faults;
+			for (auto i = 0; i < FaultLabelCount; ++i)
+				worker->EdgeLabels[i] = (faults & FaultLabelMasks[i]) != 0 ? 1 : 0;
+
+			callback(context, &info, worker->GetExportedState((unsigned char*)stateMemory), nullptr);
 
 			++transitionCount;
 		}
@@ -298,8 +877,74 @@ int32_t NextStatesCallback(model_t model, int32_t group, int32_t* state, Transit
 	}
 }
 
+int32_t EmitInitialStates(Worker^ worker, TransitionCB callback, void* context)
+{
+	// The initial states have already been computed when the model was loaded; no faults are exported for these transitions
+	transition_info info = { worker->EdgeLabels, ConstructionGroup, 0 };
+	for (auto i = 0; i < FaultLabelCount; ++i)
+		worker->EdgeLabels[i] = 0;
+
+	auto stateVectorSize = worker->RuntimeModel->StateVectorSize;
+	for (auto i = 0; i < InitialStateCount; ++i)
+		callback(context, &info, worker->GetExportedState(InitialStates + i * stateVectorSize), nullptr);
+
+	return InitialStateCount;
+}
+
+void CheckInvariants(Worker^ worker, unsigned char* state)
+{
+	worker->Deserialize(state);
+
+	for (auto i = 0; i < InvariantCount; ++i)
+	{
+		auto invariant = worker->Invariants[i];
+		if (invariant == nullptr || InvariantViolations[i] != 0 || invariant())
+			continue;
+
+		Monitor::Enter(Synchronization::Lock);
+		try
+		{
+			if (InvariantViolations[i] == 0)
+			{
+				File::AppendAllText(gcnew String(InvariantsFile), i.ToString() + Environment::NewLine);
+				InvariantViolations[i] = 1;
+				++ViolatedInvariantCount;
+			}
+		}
+		finally
+		{
+			Monitor::Exit(Synchronization::Lock);
+		}
+	}
+}
+
+void RemoveDuplicateInitialStates(Worker^ worker)
+{
+	// Initial transitions that activate different sets of faults might lead to the same initial state; as the construction
+	// group leads to all initial states regardless of the faults activated, only the first transition to each initial state
+	// is kept. The transition groups are not yet known when the initial states are loaded and are irrelevant here anyway.
+	auto transitions = worker->Transitions;
+	auto targetStates = worker->TargetStates;
+
+	if (!targetStates->Clear(worker->TransitionCount))
+		return;
+
+	auto count = 0;
+	for (auto i = 0; i < worker->TransitionCount; ++i)
+	{
+		auto candidate = transitions[i];
+
+		bool isNew;
+		targetStates->GetOrAdd((int32_t*)candidate->TargetStatePointer, count, &isNew);
+		if (isNew)
+			transitions[count++] = candidate;
+	}
+
+	worker->TransitionCount = count;
+}
+
 //---------------------------------------------------------------------------------------------------------------------------
-// State label function
+// State label functions
 //---------------------------------------------------------------------------------------------------------------------------
 int32_t StateLabelCallback(model_t model, int32_t label, int32_t* state)
 {
@@ -307,8 +952,17 @@ int32_t StateLabelCallback(model_t model, int32_t label, int32_t* state)
 
 	try
 	{
-		Globals::RuntimeModel->Deserialize((unsigned char*)state);
-		return Globals::RuntimeModel->ExecutableStateFormulas[label]->Expression() ? 1 : 0;
+		if (label == InitialChoiceLabel)
+			return IsConstructionState(state) ? 1 : 0;
+
+		auto worker = GetWorker();
+		auto packedState = worker->GetPackedState(state);
+
+		// Labels evaluated natively are cheaper to recompute than to look up in the cache
+		if (worker->LabelCache == nullptr || LabelEvaluator->CanEvaluate(label))
+			return EvaluateStateLabel(worker, label, packedState);
+
+		return (EvaluateStateLabels(worker, (int32_t*)packedState) >> LabelCacheBits[label]) & 1;
 	}
 	catch (Exception^ e)
 	{
@@ -319,12 +973,363 @@ int32_t StateLabelCallback(model_t model, int32_t label, int32_t* state)
 	}
 }
 
+void StateLabelsAllCallback(model_t model, int32_t* state, int32_t* labels)
+{
+	(void)model;
+
+	try
+	{
+		auto worker = GetWorker();
+		auto packedState = worker->GetPackedState(state);
+		auto stateLabelCount = worker->RuntimeModel->ExecutableStateFormulas->Length;
+		labels[InitialChoiceLabel] = IsConstructionState(state) ? 1 : 0;
+
+		if (worker->LabelCache == nullptr)
+		{
+			for (auto i = 0; i < stateLabelCount; ++i)
+				labels[i] = EvaluateStateLabel(worker, i, packedState);
+
+			return;
+		}
+
+		auto values = EvaluateStateLabels(worker, (int32_t*)packedState);
+		for (auto i = 0; i < stateLabelCount; ++i)
+			labels[i] = LabelCacheBits[i] == -1 ? EvaluateStateLabel(worker, i, packedState) : (values >> LabelCacheBits[i]) & 1;
+	}
+	catch (Exception^ e)
+	{
+		Console::WriteLine(e);
+		ltsmin_abort(255);
+	}
+}
+
+void StateLabelsGroupCallback(model_t model, sl_group_enum_t group, int32_t* state, int32_t* labels)
+{
+	// The model does not have any guards, so the only non-empty label group is the one containing all labels
+	if (group == GB_SL_ALL)
+		StateLabelsAllCallback(model, state, labels);
+}
+
+uint32_t EvaluateStateLabels(Worker^ worker, int32_t* state)
+{
+	uint32_t labels;
+	if (worker->LabelCache->TryGet(state, &labels))
+		return labels;
+
+	// The state's labels are not cached, so we evaluate all managed labels; the state is deserialized at most once
+	labels = 0;
+	for (auto i = 0; i < ManagedLabelCount; ++i)
+		labels |= EvaluateStateLabel(worker, ManagedLabels[i], (unsigned char*)state) != 0 ? 1u << i : 0u;
+
+	worker->LabelCache->Add(state, labels);
+	return labels;
+}
+
+int32_t EvaluateStateLabel(Worker^ worker, int32_t label, unsigned char* state)
+{
+	auto value = LabelEvaluator->Evaluate(label, state);
+	if (value != StateLabelEvaluator::Unknown)
+		return value;
+
+	// The label's formula could not be compiled or a reference it depends on differs from the one it was compiled for
+	worker->Deserialize(state);
+	return worker->RuntimeModel->ExecutableStateFormulas[label]->Expression() ? 1 : 0;
+}
+
+array<array<int32_t>^>^ CompileStateLabels(array<array<int32_t>^>^ programs)
+{
+	// The programs only consist of offsets into the state vector and constants, so they can be shared by all workers; they
+	// only have to be compiled if they have not been cached
+	auto formulas = Globals::RuntimeModel->ExecutableStateFormulas;
+	if (programs == nullptr)
+	{
+		auto compiler = gcnew StateFormulaCompiler(Globals::RuntimeModel, StateHeaderBytes);
+		programs = gcnew array<array<int32_t>^>(formulas->Length);
+
+		for (auto i = 0; i < formulas->Length; ++i)
+			programs[i] = compiler->Compile(formulas[i]);
+	}
+
+	auto compiledCount = 0;
+	LabelEvaluator = new StateLabelEvaluator(formulas->Length);
+
+	for (auto i = 0; i < formulas->Length; ++i)
+	{
+		auto program = programs[i];
+		if (program == nullptr)
+			continue;
+
+		pin_ptr<int32_t> instructions = &program[0];
+		if (LabelEvaluator->SetProgram(i, instructions, program->Length))
+			++compiledCount;
+	}
+
+	ManagedLabelCount = 0;
+	ManagedLabels = (int32_t*)calloc(formulas->Length + 1, sizeof(int32_t));
+	LabelCacheBits = (int32_t*)calloc(formulas->Length + 1, sizeof(int32_t));
+
+	for (auto i = 0; i < formulas->Length; ++i)
+	{
+		if (LabelEvaluator->CanEvaluate(i))
+			LabelCacheBits[i] = -1;
+		else
+		{
+			LabelCacheBits[i] = ManagedLabelCount;
+			ManagedLabels[ManagedLabelCount++] = i;
+		}
+	}
+
+	if (ReportModelDetails)
+		Console::WriteLine("Evaluating {0} of {1} state labels natively.", compiledCount, formulas->Length);
+	return programs;
+}
+
+//---------------------------------------------------------------------------------------------------------------------------
+// Transition groups
+//---------------------------------------------------------------------------------------------------------------------------
+void SetDependencies(int32_t group, array<bool>^ reads, array<bool>^ writes)
+{
+	for (auto i = 0; i < reads->Length; ++i)
+	{
+		if (reads[i] || writes[i])
+		{
+			dm_set(&CombinedMatrix, group, i);
+			dm_set(&ReadMatrix, group, i);
+		}
+
+		if (writes[i])
+			dm_set(&WriteMatrix, group, i);
+	}
+}
+
+void DetermineTransitionGroups()
+{
+	auto faults = Globals::RuntimeModel->NondeterministicFaults;
+
+	ConstructionGroup = StateHeaderBytes != 0 ? 0 : -1;
+	NoFaultsGroup = ConstructionGroup + 1;
+	MultipleFaultsGroup = faults->Length > 1 ? NoFaultsGroup + faults->Length + 1 : -1;
+	TransitionGroupCount = faults->Length > 1 ? MultipleFaultsGroup + 1 : NoFaultsGroup + faults->Length + 1;
+
+	for (auto i = 0; i < faults->Length; ++i)
+		FaultGroups[faults[i]->Identifier] = NoFaultsGroup + 1 + i;
+}
+
+array<StateAccessSet^>^ AnalyzeTransitionGroups(StateAccessAnalysis^ analysis)
+{
+	auto faults = Globals::RuntimeModel->NondeterministicFaults;
+
+	// For all groups except for the construction group, we statically determine the state slots that might be accessed when
+	// only the group's faults are activated; as these include the slots accessed when no faults are activated, a transition
+	// dropped by the executed model because another transition reaches the same target with fewer activated faults is dropped
+	// based on the slots read by the group of the dropped transition only
+	auto groupAccesses = gcnew array<StateAccessSet^>(TransitionGroupCount);
+	for (auto group = NoFaultsGroup; group < TransitionGroupCount; ++group)
+	{
+		array<Fault^>^ activatableFaults;
+		if (group == NoFaultsGroup)
+			activatableFaults = gcnew array<Fault^>(0);
+		else if (group == MultipleFaultsGroup)
+			activatableFaults = faults;
+		else
+			activatableFaults = gcnew array<Fault^> { faults[group - NoFaultsGroup - 1] };
+
+		groupAccesses[group] = analysis->AnalyzeStep(FaultSet(activatableFaults));
+		if (!groupAccesses[group]->IsComplete)
+			Console::WriteLine("Unable to determine the state slots accessed by transition group {0}; assuming all slots are accessed.", group);
+	}
+
+	return groupAccesses;
+}
+
+void InitializeTransitionGroups(int32_t stateSlotCount, array<StateAccessSet^>^ groupAccesses)
+{
+	dm_create(&CombinedMatrix, TransitionGroupCount, stateSlotCount);
+	dm_create(&ReadMatrix, TransitionGroupCount, stateSlotCount);
+	dm_create(&WriteMatrix, TransitionGroupCount, stateSlotCount);
+
+	// The initial transitions only depend on the header slot, but write all slots
+	auto constructionSlot = gcnew array<bool>(stateSlotCount);
+	if (StateHeaderBytes != 0)
+	{
+		auto allSlots = gcnew array<bool>(stateSlotCount);
+		for (auto i = 0; i < stateSlotCount; ++i)
+			allSlots[i] = true;
+
+		constructionSlot[0] = true;
+		SetDependencies(ConstructionGroup, constructionSlot, allSlots);
+	}
+
+	// All other groups depend on the slots they might access; additionally, all of these groups have to check whether they
+	// are applied to the pseudo initial state
+	for (auto group = NoFaultsGroup; group < TransitionGroupCount; ++group)
+	{
+		SetDependencies(group, constructionSlot, gcnew array<bool>(stateSlotCount));
+		SetDependencies(group, GetReadSlots(groupAccesses[group]), GetWrittenSlots(groupAccesses[group]));
+	}
+
+	if (ReportModelDetails)
+		Console::WriteLine("Transition groups: {0}", TransitionGroupCount);
+}
+
+int32_t GetTransitionGroup(CandidateTransition* transition)
+{
+	auto faults = (uint64_t)transition->ActivatedFaults._faults;
+	if (faults == 0)
+		return NoFaultsGroup;
+
+	if ((faults & (faults - 1)) != 0)
+		return MultipleFaultsGroup;
+
+	unsigned long index;
+	_BitScanForward64(&index, faults);
+	return FaultGroups[index];
+}
+
+//---------------------------------------------------------------------------------------------------------------------------
+// State label dependencies
+//---------------------------------------------------------------------------------------------------------------------------
+array<StateAccessSet^>^ AnalyzeStateLabels(StateAccessAnalysis^ analysis)
+{
+	auto formulas = Globals::RuntimeModel->ExecutableStateFormulas;
+	auto labelAccesses = gcnew array<StateAccessSet^>(formulas->Length);
+
+	// Each label only depends on the slots its formula's expression might read
+	for (auto i = 0; i < formulas->Length; ++i)
+	{
+		labelAccesses[i] = analysis->AnalyzeDelegate(formulas[i]->Expression);
+		if (!labelAccesses[i]->IsComplete)
+			Console::WriteLine("Unable to determine the state slots read by state label {0}; assuming all slots are read.", i);
+	}
+
+	return labelAccesses;
+}
+
+void InitializeStateLabelMatrix(int32_t stateSlotCount, array<StateAccessSet^>^ labelAccesses)
+{
+	auto formulas = Globals::RuntimeModel->ExecutableStateFormulas;
+	InitialChoiceLabel = formulas->Length;
+	dm_create(&StateLabelMatrix, formulas->Length + 1, stateSlotCount);
+
+	// The label marking the pseudo initial state only depends on the header slot
+	if (StateHeaderBytes != 0)
+		dm_set(&StateLabelMatrix, InitialChoiceLabel, 0);
+
+	for (auto i = 0; i < formulas->Length; ++i)
+	{
+		auto reads = GetReadSlots(labelAccesses[i]);
+		for (auto j = 0; j < stateSlotCount; ++j)
+		{
+			if (reads[j])
+				dm_set(&StateLabelMatrix, i, j);
+		}
+	}
+}
+
+//---------------------------------------------------------------------------------------------------------------------------
+// State variable ordering
+//---------------------------------------------------------------------------------------------------------------------------
+array<StateVariable^>^ OrderStateVariables(array<StateVariable^>^ variables, array<StateAccessSet^>^ groupAccesses, array<StateAccessSet^>^ labelAccesses)
+{
+	// The order of the exported slots determines the variable order of the decision diagrams used by the symbolic tools; hence,
+	// the variables accessed by the same transition groups and state labels are placed next to each other
+	auto dependencies = gcnew List<array<bool>^>();
+	for each (auto accesses in groupAccesses)
+	{
+		if (accesses == nullptr)
+			continue;
+
+		auto reads = accesses->GetReadVariables(variables);
+		auto writes = accesses->GetWrittenVariables(variables);
+		for (auto i = 0; i < reads->Length; ++i)
+			reads[i] |= writes[i];
+
+		dependencies->Add(reads);
+	}
+
+	for each (auto accesses in labelAccesses)
+		dependencies->Add(accesses->GetReadVariables(variables));
+
+	return StateVariableOrdering::Order(variables, dependencies);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------
+// Mapping of state accesses to exported slots
+//---------------------------------------------------------------------------------------------------------------------------
+array<bool>^ GetReadSlots(StateAccessSet^ accesses)
+{
+	if (VariableLayout != nullptr)
+		return accesses->GetReadVariables(Globals::StateVariables);
+
+	return accesses->GetReadWords(StateHeaderBytes);
+}
+
+array<bool>^ GetWrittenSlots(StateAccessSet^ accesses)
+{
+	if (VariableLayout != nullptr)
+		return accesses->GetWrittenVariables(Globals::StateVariables);
+
+	return accesses->GetWrittenWords(StateHeaderBytes);
+}
+
+//---------------------------------------------------------------------------------------------------------------------------
+// Initial states
+//---------------------------------------------------------------------------------------------------------------------------
+void LoadInitialStates(RuntimeModelSerializer^ serializer)
+{
+	// The initial states are computed without a state header, which is only required when there is more than one of them
+	auto worker = gcnew Worker(serializer, 0);
+	worker->SetTransitions(worker->ExecutedModel->GetInitialTransitions());
+	RemoveDuplicateInitialStates(worker);
+
+	auto modelStateSize = worker->RuntimeModel->StateVectorSize;
+	StateHeaderBytes = worker->TransitionCount > 1 ? (int32_t)sizeof(int32_t) : 0;
+	InitialStateCount = worker->TransitionCount;
+
+	// The initial states are stored in the exported layout, i.e., with a zeroed header slot if necessary
+	auto stateVectorSize = StateHeaderBytes + modelStateSize;
+	InitialStates = (unsigned char*)calloc(InitialStateCount, stateVectorSize);
+	if (InitialStates == nullptr)
+		throw gcnew OutOfMemoryException("Unable to allocate the initial states.");
+
+	for (auto i = 0; i < InitialStateCount; ++i)
+		memcpy(InitialStates + i * stateVectorSize + StateHeaderBytes, worker->Transitions[i]->TargetStatePointer, modelStateSize);
+}
+
+void RestoreInitialStates(LtsMinModelArtifacts^ artifacts)
+{
+	StateHeaderBytes = artifacts->StateHeaderBytes;
+	InitialStateCount = artifacts->InitialStateCount;
+
+	// The cached initial states are already stored in the exported layout
+	InitialStates = (unsigned char*)malloc(artifacts->InitialStates->Length);
+	if (InitialStates == nullptr)
+		throw gcnew OutOfMemoryException("Unable to allocate the initial states.");
+
+	Marshal::Copy(artifacts->InitialStates, 0, IntPtr(InitialStates), artifacts->InitialStates->Length);
+}
+
 //---------------------------------------------------------------------------------------------------------------------------
-// Construction State Check
+// Model artifacts
 //---------------------------------------------------------------------------------------------------------------------------
+void SaveArtifacts(String^ key, array<array<int32_t>^>^ labelPrograms, array<StateAccessSet^>^ groupAccesses, array<StateAccessSet^>^ labelAccesses)
+{
+	auto initialStates = gcnew array<Byte>(InitialStateCount * Globals::RuntimeModel->StateVectorSize);
+	Marshal::Copy(IntPtr(InitialStates), initialStates, 0, initialStates->Length);
+
+	auto artifacts = gcnew LtsMinModelArtifacts();
+	artifacts->StateHeaderBytes = StateHeaderBytes;
+	artifacts->InitialStateCount = InitialStateCount;
+	artifacts->InitialStates = initialStates;
+	artifacts->LabelPrograms = labelPrograms;
+	artifacts->GroupAccesses = groupAccesses;
+	artifacts->LabelAccesses = labelAccesses;
+	artifacts->Save(gcnew String(ArtifactsDirectory), key);
+}
+
 bool IsConstructionState(int32_t* state)
 {
-	return state[0] == 1;
+	return StateHeaderBytes != 0 && state[0] == 1;
 }
 
 //---------------------------------------------------------------------------------------------------------------------------
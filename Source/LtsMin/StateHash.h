@@ -0,0 +1,49 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+//---------------------------------------------------------------------------------------------------------------------------
+// C standard library includes
+//---------------------------------------------------------------------------------------------------------------------------
+#include <cstdint>
+
+//---------------------------------------------------------------------------------------------------------------------------
+// State hashing
+//---------------------------------------------------------------------------------------------------------------------------
+
+// Computes a hash of the given state vector: a 64-bit FNV-1a over the state vector's words, followed by a final avalanche
+// step so that the low bits can be used to index power-of-two sized tables.
+inline uint64_t HashState(const int32_t* state, int32_t stateVectorSize)
+{
+	auto hash = 14695981039346656037ull;
+	for (auto i = 0; i < stateVectorSize / (int32_t)sizeof(int32_t); ++i)
+	{
+		hash ^= (uint32_t)state[i];
+		hash *= 1099511628211ull;
+	}
+
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdull;
+	hash ^= hash >> 33;
+	return hash;
+}
@@ -0,0 +1,117 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+//---------------------------------------------------------------------------------------------------------------------------
+// C standard library includes
+//---------------------------------------------------------------------------------------------------------------------------
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+
+//---------------------------------------------------------------------------------------------------------------------------
+// Plugin includes
+//---------------------------------------------------------------------------------------------------------------------------
+#include "StateHash.h"
+
+//---------------------------------------------------------------------------------------------------------------------------
+// State label cache
+//---------------------------------------------------------------------------------------------------------------------------
+
+// Caches the state label values of state vectors. The executed model already evaluates the managed state formulas for the
+// target state of each transition it generates; the next states callback stores these values here so that LTSmin's
+// subsequent label queries for the state do not have to deserialize the state and re-evaluate the formulas. The cache is
+// direct mapped, i.e., newer entries evict older ones; a miss therefore only means that the labels have to be recomputed.
+// The values of a state's labels are stored as a 32 bit mask, so the cache is not used for models with 32 or more managed
+// labels; these models always evaluate their labels on demand.
+class StateLabelCache
+{
+public:
+	// The maximum number of bytes allocated for the cache entries.
+	static const size_t MaxMemory = 64 * 1024 * 1024;
+
+	// The maximum number of entries stored by the cache.
+	static const size_t MaxCapacity = 1 << 18;
+
+	StateLabelCache(int32_t stateVectorSize)
+		: _stateVectorSize(stateVectorSize), _entrySize(sizeof(Entry) + stateVectorSize), _capacity(MaxCapacity)
+	{
+		while (_capacity > 1 && _capacity * _entrySize > MaxMemory)
+			_capacity >>= 1;
+
+		_entries = (unsigned char*)calloc(_capacity, _entrySize);
+		if (_entries == nullptr)
+			_capacity = 0;
+	}
+
+	~StateLabelCache()
+	{
+		free(_entries);
+	}
+
+	StateLabelCache(const StateLabelCache&) = delete;
+	StateLabelCache& operator=(const StateLabelCache&) = delete;
+
+	// Stores the label values of the given state, evicting the entry that was previously stored in the same slot, if any.
+	void Add(const int32_t* state, uint32_t labels)
+	{
+		if (_capacity == 0)
+			return;
+
+		auto entry = GetEntry(state);
+		entry->IsValid = 1;
+		entry->Labels = labels;
+		memcpy(entry + 1, state, _stateVectorSize);
+	}
+
+	// Tries to retrieve the label values of the given state; returns false if the state's labels are not cached.
+	bool TryGet(const int32_t* state, uint32_t* labels) const
+	{
+		if (_capacity == 0)
+			return false;
+
+		auto entry = GetEntry(state);
+		if (entry->IsValid == 0 || memcmp(entry + 1, state, _stateVectorSize) != 0)
+			return false;
+
+		*labels = entry->Labels;
+		return true;
+	}
+
+private:
+	struct Entry
+	{
+		uint32_t IsValid;
+		uint32_t Labels;
+	};
+
+	Entry* GetEntry(const int32_t* state) const
+	{
+		return (Entry*)(_entries + (HashState(state, _stateVectorSize) & (_capacity - 1)) * _entrySize);
+	}
+
+	int32_t _stateVectorSize;
+	size_t _entrySize;
+	size_t _capacity;
+	unsigned char* _entries;
+};
@@ -0,0 +1,244 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+//---------------------------------------------------------------------------------------------------------------------------
+// C standard library includes
+//---------------------------------------------------------------------------------------------------------------------------
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+
+//---------------------------------------------------------------------------------------------------------------------------
+// Plugin includes
+//---------------------------------------------------------------------------------------------------------------------------
+#include "VariableStateLayout.h"
+
+//---------------------------------------------------------------------------------------------------------------------------
+// State label evaluator
+//---------------------------------------------------------------------------------------------------------------------------
+
+// Evaluates state labels directly on S#'s bit-packed state vectors, using the programs generated for the labels' formulas by
+// S#'s StateFormulaCompiler. The managed evaluation of a label requires the state to be deserialized into the model's objects
+// first, which is much more expensive than decoding the few values a formula typically reads. Labels without a program and
+// evaluations aborted by a failed guard must be evaluated by the managed formulas instead. The programs are immutable once
+// they have been set, so a single evaluator can be shared by all worker threads.
+class StateLabelEvaluator
+{
+public:
+	// The opcodes of the programs' instructions; they must match the values of S#'s StateFormulaOpCode enumeration.
+	enum class OpCode : int32_t
+	{
+		Return = 0,
+		Constant = 1,
+		Load = 2,
+		Guard = 3,
+		LoadLocal = 4,
+		StoreLocal = 5,
+		Duplicate = 6,
+		Pop = 7,
+		Add = 8,
+		Subtract = 9,
+		Multiply = 10,
+		And = 11,
+		Or = 12,
+		Xor = 13,
+		ShiftLeft = 14,
+		ShiftRight = 15,
+		ShiftRightUnsigned = 16,
+		Equal = 17,
+		Less = 18,
+		LessUnsigned = 19,
+		Greater = 20,
+		GreaterUnsigned = 21,
+		Not = 22,
+		Negate = 23,
+		Jump = 24,
+		JumpIfTrue = 25,
+		JumpIfFalse = 26
+	};
+
+	// The maximum stack size and number of local variables of the programs; they must match the limits of the compiler.
+	static const int32_t MaxStackSize = 64;
+	static const int32_t MaxLocalCount = 64;
+
+	// The value returned when a label cannot be evaluated natively.
+	static const int32_t Unknown = -1;
+
+	StateLabelEvaluator(int32_t labelCount)
+		: _labelCount(labelCount)
+	{
+		_programs = (int32_t**)calloc(labelCount, sizeof(int32_t*));
+	}
+
+	~StateLabelEvaluator()
+	{
+		for (auto i = 0; i < _labelCount; ++i)
+			free(_programs[i]);
+
+		free(_programs);
+	}
+
+	StateLabelEvaluator(const StateLabelEvaluator&) = delete;
+	StateLabelEvaluator& operator=(const StateLabelEvaluator&) = delete;
+
+	// Sets the program evaluating the label with the given index.
+	bool SetProgram(int32_t label, const int32_t* program, int32_t length)
+	{
+		auto copy = (int32_t*)malloc(length * sizeof(int32_t));
+		if (copy == nullptr)
+			return false;
+
+		memcpy(copy, program, length * sizeof(int32_t));
+		free(_programs[label]);
+		_programs[label] = copy;
+
+		return true;
+	}
+
+	// Checks whether the label with the given index has a program.
+	bool CanEvaluate(int32_t label) const
+	{
+		return _programs[label] != nullptr;
+	}
+
+	// Evaluates the label with the given index for the given packed state, returning 1 if the label holds, 0 if it does not,
+	// or Unknown if the label must be evaluated by the managed formula instead.
+	int32_t Evaluate(int32_t label, const unsigned char* state) const
+	{
+		auto program = _programs[label];
+		if (program == nullptr)
+			return Unknown;
+
+		int32_t stack[MaxStackSize];
+		int32_t locals[MaxLocalCount] = {};
+		auto top = -1;
+		auto pc = 0;
+
+		// The arithmetic is performed on unsigned values, which wrap around on overflow just like the CLR's integers do
+		for (;;)
+		{
+			switch ((OpCode)program[pc])
+			{
+			case OpCode::Return:
+				return stack[top] != 0 ? 1 : 0;
+			case OpCode::Constant:
+				stack[++top] = program[pc + 1];
+				pc += 2;
+				break;
+			case OpCode::Load:
+				stack[++top] = VariableStateLayout::ReadValue(state, program[pc + 1], program[pc + 2], program[pc + 3] != 0);
+				pc += 4;
+				break;
+			case OpCode::Guard:
+				if (VariableStateLayout::ReadValue(state, program[pc + 1], program[pc + 2], false) != program[pc + 3])
+					return Unknown;
+				pc += 4;
+				break;
+			case OpCode::LoadLocal:
+				stack[++top] = locals[program[pc + 1]];
+				pc += 2;
+				break;
+			case OpCode::StoreLocal:
+				locals[program[pc + 1]] = stack[top--];
+				pc += 2;
+				break;
+			case OpCode::Duplicate:
+				stack[top + 1] = stack[top];
+				++top;
+				++pc;
+				break;
+			case OpCode::Pop:
+				--top;
+				++pc;
+				break;
+			case OpCode::Not:
+				stack[top] = ~stack[top];
+				++pc;
+				break;
+			case OpCode::Negate:
+				stack[top] = (int32_t)(0u - (uint32_t)stack[top]);
+				++pc;
+				break;
+			case OpCode::Jump:
+				pc = program[pc + 1];
+				break;
+			case OpCode::JumpIfTrue:
+				pc = stack[top--] != 0 ? program[pc + 1] : pc + 2;
+				break;
+			case OpCode::JumpIfFalse:
+				pc = stack[top--] == 0 ? program[pc + 1] : pc + 2;
+				break;
+			default:
+				stack[top - 1] = EvaluateBinary((OpCode)program[pc], stack[top - 1], stack[top]);
+				--top;
+				++pc;
+				break;
+			}
+		}
+	}
+
+private:
+	static int32_t EvaluateBinary(OpCode opCode, int32_t left, int32_t right)
+	{
+		auto l = (uint32_t)left;
+		auto r = (uint32_t)right;
+
+		switch (opCode)
+		{
+		case OpCode::Add:
+			return (int32_t)(l + r);
+		case OpCode::Subtract:
+			return (int32_t)(l - r);
+		case OpCode::Multiply:
+			return (int32_t)(l * r);
+		case OpCode::And:
+			return (int32_t)(l & r);
+		case OpCode::Or:
+			return (int32_t)(l | r);
+		case OpCode::Xor:
+			return (int32_t)(l ^ r);
+		case OpCode::ShiftLeft:
+			return (int32_t)(l << (r & 31));
+		case OpCode::ShiftRight:
+			return left >> (r & 31);
+		case OpCode::ShiftRightUnsigned:
+			return (int32_t)(l >> (r & 31));
+		case OpCode::Equal:
+			return left == right ? 1 : 0;
+		case OpCode::Less:
+			return left < right ? 1 : 0;
+		case OpCode::LessUnsigned:
+			return l < r ? 1 : 0;
+		case OpCode::Greater:
+			return left > right ? 1 : 0;
+		case OpCode::GreaterUnsigned:
+			return l > r ? 1 : 0;
+		default:
+			abort();
+		}
+	}
+
+	int32_t _labelCount;
+	int32_t** _programs;
+};
@@ -0,0 +1,115 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+//---------------------------------------------------------------------------------------------------------------------------
+// C standard library includes
+//---------------------------------------------------------------------------------------------------------------------------
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+
+//---------------------------------------------------------------------------------------------------------------------------
+// Plugin includes
+//---------------------------------------------------------------------------------------------------------------------------
+#include "StateHash.h"
+
+//---------------------------------------------------------------------------------------------------------------------------
+// Target state table
+//---------------------------------------------------------------------------------------------------------------------------
+
+// Maps the distinct target states of a single state's successor transitions to the indices of the transitions that are
+// emitted for them. The table only stores pointers to the target states, which must therefore remain valid until the
+// table is cleared.
+class TargetStateTable
+{
+public:
+	TargetStateTable(int32_t stateVectorSize)
+		: _stateVectorSize(stateVectorSize), _capacity(0), _entries(nullptr)
+	{
+	}
+
+	~TargetStateTable()
+	{
+		free(_entries);
+	}
+
+	TargetStateTable(const TargetStateTable&) = delete;
+	TargetStateTable& operator=(const TargetStateTable&) = delete;
+
+	// Removes all entries and ensures that the table can store the given number of target states.
+	bool Clear(int32_t count)
+	{
+		auto capacity = _capacity == 0 ? 64 : _capacity;
+		while (capacity < 2 * (size_t)count)
+			capacity <<= 1;
+
+		if (capacity != _capacity)
+		{
+			auto entries = (Entry*)realloc(_entries, capacity * sizeof(Entry));
+			if (entries == nullptr)
+				return false;
+
+			_entries = entries;
+			_capacity = capacity;
+		}
+
+		memset(_entries, 0, _capacity * sizeof(Entry));
+		return true;
+	}
+
+	// Looks up the given target state; if the state has not been added before, it is added with the given transition
+	// index. Returns a reference to the transition index stored for the state.
+	int32_t& GetOrAdd(const int32_t* state, int32_t index, bool* isNew)
+	{
+		auto mask = _capacity - 1;
+		for (auto i = HashState(state, _stateVectorSize) & mask; ; i = (i + 1) & mask)
+		{
+			auto& entry = _entries[i];
+			if (entry.State == nullptr)
+			{
+				entry.State = state;
+				entry.Index = index;
+				*isNew = true;
+				return entry.Index;
+			}
+
+			if (memcmp(entry.State, state, _stateVectorSize) == 0)
+			{
+				*isNew = false;
+				return entry.Index;
+			}
+		}
+	}
+
+private:
+	struct Entry
+	{
+		const int32_t* State;
+		int32_t Index;
+	};
+
+	int32_t _stateVectorSize;
+	size_t _capacity;
+	Entry* _entries;
+};
@@ -0,0 +1,144 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+//---------------------------------------------------------------------------------------------------------------------------
+// C standard library includes
+//---------------------------------------------------------------------------------------------------------------------------
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+
+//---------------------------------------------------------------------------------------------------------------------------
+// Variable state layout
+//---------------------------------------------------------------------------------------------------------------------------
+
+// Converts between S#'s bit-packed state vectors and state vectors with one 32 bit slot per state variable. The packed
+// vectors store small values such as Booleans or range-restricted integers in as few bits as possible, so that a single
+// 32 bit word usually contains several unrelated values; LTSmin's compression schemes and symbolic encodings work much
+// better when each slot holds exactly one variable.
+class VariableStateLayout
+{
+public:
+	VariableStateLayout(int32_t packedSize, int32_t variableCount)
+		: _packedSize(packedSize), _variableCount(variableCount)
+	{
+		_variables = (Variable*)calloc(variableCount, sizeof(Variable));
+	}
+
+	~VariableStateLayout()
+	{
+		free(_variables);
+	}
+
+	VariableStateLayout(const VariableStateLayout&) = delete;
+	VariableStateLayout& operator=(const VariableStateLayout&) = delete;
+
+	// Sets the location of the variable with the given index within the packed state vector.
+	void SetVariable(int32_t index, int32_t offsetInBits, int32_t sizeInBits, bool isSigned)
+	{
+		_variables[index].OffsetInBits = offsetInBits;
+		_variables[index].SizeInBits = sizeInBits;
+		_variables[index].IsSigned = isSigned;
+	}
+
+	// Gets the number of variables, i.e., the number of slots of an unpacked state vector.
+	int32_t GetVariableCount() const
+	{
+		return _variableCount;
+	}
+
+	// Extracts the values of all variables from the packed state vector.
+	void Unpack(const unsigned char* packed, int32_t* variables) const
+	{
+		for (auto i = 0; i < _variableCount; ++i)
+		{
+			auto& variable = _variables[i];
+			variables[i] = ReadValue(packed, variable.OffsetInBits, variable.SizeInBits, variable.IsSigned);
+		}
+	}
+
+	// Reads a single value of at most 32 bits from the packed state vector, sign-extending it if necessary.
+	static int32_t ReadValue(const unsigned char* packed, int32_t offsetInBits, int32_t sizeInBits, bool isSigned)
+	{
+		auto value = (uint32_t)ReadBits(packed, offsetInBits, sizeInBits);
+
+		if (isSigned && sizeInBits < 32)
+		{
+			auto shift = 32 - sizeInBits;
+			return (int32_t)(value << shift) >> shift;
+		}
+
+		return (int32_t)value;
+	}
+
+	// Stores the values of all variables in the packed state vector; bits not covered by any variable are set to zero.
+	void Pack(const int32_t* variables, unsigned char* packed) const
+	{
+		memset(packed, 0, _packedSize);
+
+		for (auto i = 0; i < _variableCount; ++i)
+			WriteBits(packed, _variables[i].OffsetInBits, _variables[i].SizeInBits, (uint32_t)variables[i]);
+	}
+
+private:
+	struct Variable
+	{
+		int32_t OffsetInBits;
+		int32_t SizeInBits;
+		bool IsSigned;
+	};
+
+	// The packed vectors store values little endian with Booleans packed into bytes starting at the least significant bit,
+	// so all values can be accessed as bit ranges of the vector; a variable spans at most 5 bytes.
+	static uint64_t ReadBits(const unsigned char* packed, int32_t offsetInBits, int32_t sizeInBits)
+	{
+		auto first = offsetInBits / 8;
+		auto last = (offsetInBits + sizeInBits - 1) / 8;
+
+		uint64_t value = 0;
+		for (auto i = last; i >= first; --i)
+			value = (value << 8) | packed[i];
+
+		return (value >> (offsetInBits % 8)) & Mask(sizeInBits);
+	}
+
+	static void WriteBits(unsigned char* packed, int32_t offsetInBits, int32_t sizeInBits, uint32_t value)
+	{
+		auto first = offsetInBits / 8;
+		auto last = (offsetInBits + sizeInBits - 1) / 8;
+		auto bits = (value & Mask(sizeInBits)) << (offsetInBits % 8);
+
+		for (auto i = first; i <= last; ++i)
+			packed[i] |= (unsigned char)(bits >> ((i - first) * 8));
+	}
+
+	static uint64_t Mask(int32_t sizeInBits)
+	{
+		return (1ull << sizeInBits) - 1;
+	}
+
+	int32_t _packedSize;
+	int32_t _variableCount;
+	Variable* _variables;
+};
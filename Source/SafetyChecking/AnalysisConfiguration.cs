@@ -56,6 +56,7 @@ namespace ISSE.SafetyChecking
 		private int _cpuCount;
 		private long _stackCapacity;
 		private long _successorStateCapacity;
+		private long _initialSuccessorStateCapacity;
 
 		/// <summary>
 		/// </summary>
@@ -166,6 +167,27 @@ namespace ISSE.SafetyChecking
 			}
 		}
 
+		/// <summary>
+		///   Gets or sets the number of successor states the successor buffers are initially allocated for. The buffers grow on
+		///   demand, doubling their capacity up to <see cref="SuccessorCapacity" />. Unless set explicitly, the buffers are allocated
+		///   for <see cref="SuccessorCapacity" /> successor states right away.
+		/// </summary>
+		public long InitialSuccessorCapacity
+		{
+			get
+			{
+				if (_initialSuccessorStateCapacity == 0)
+					return SuccessorCapacity;
+
+				return Math.Min(_initialSuccessorStateCapacity, SuccessorCapacity);
+			}
+			set
+			{
+				Requires.That(value >= MinCapacity, $"{nameof(InitialSuccessorCapacity)} must be at least {MinCapacity}.");
+				_initialSuccessorStateCapacity = value;
+			}
+		}
+
 		/// <summary>
 		///   Gets or sets the number of CPUs that are used for model checking. The value is automatically clamped
 		///   to the interval of [1, #CPUs].
@@ -196,6 +218,11 @@ namespace ISSE.SafetyChecking
 		public bool EnableStaticPruningOptimization { get; set; }
 		
 		/// <summary>
+		///   The maximum number of faults that may be activated nondeterministically within a single step, or <c>null</c> if the
+		///   number is unlimited. This is not a limit of the faults active in a state: faults whose activation is forced and faults
+		///   that remain active from earlier steps, e.g. permanent faults, are not counted. Once the limit is reached, all remaining
+		///   faults of the step are not activated, so these paths are pruned while the successors are computed. Honored by the
+		///   qualitative analyses and by LtsMin, but not by the probabilistic analyses.
 		/// </summary>
 		public int? LimitOfActiveFaults{ get; set; }
 
@@ -123,6 +123,27 @@ namespace ISSE.SafetyChecking.AnalysisModel
 			return valid;
 		}
 
+		/// <summary>
+		///   Stores pointers to all valid transitions of the collection in <paramref name="buffer" />, allowing callers to iterate
+		///   over the valid transitions in a plain loop without going through the collection's enumerator. Returns the number of
+		///   valid transitions.
+		/// </summary>
+		/// <param name="buffer">The buffer the pointers are stored in; must provide space for at least <see cref="Count" /> pointers.</param>
+		public int GetValidTransitions(Transition** buffer)
+		{
+			var validCount = 0;
+			var position = (byte*)_transitions;
+
+			for (var i = 0; i < Count; ++i, position += _transitionSize)
+			{
+				var transition = (Transition*)position;
+				if (TransitionFlags.IsValid(transition->Flags))
+					buffer[validCount++] = transition;
+			}
+
+			return validCount;
+		}
+
 		/// <summary>
 		///   Gets an enumerator that can be used to iterate through the collection.
 		/// </summary>
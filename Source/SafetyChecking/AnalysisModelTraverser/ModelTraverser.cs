@@ -27,6 +27,7 @@ namespace ISSE.SafetyChecking.AnalysisModelTraverser
 	using System.Diagnostics;
 	using System.Linq;
 	using System.Runtime.ExceptionServices;
+	using System.Threading;
 	using System.Threading.Tasks;
 	using ExecutableModel;
 	using AnalysisModel;
@@ -112,22 +113,36 @@ namespace ISSE.SafetyChecking.AnalysisModelTraverser
 		public IEnumerable<AnalysisModel> AnalyzedModels => _workers.Select(worker => worker.Model);
 
 		/// <summary>
-		///   Traverses the model.
+		///   Traverses the model. Returns <c>false</c> if the traversal has been cut short by the
+		///   <paramref name="cancellationToken" />.
 		/// </summary>
-		private void TraverseModel()
+		/// <param name="cancellationToken">The token that can be used to terminate the traversal early.</param>
+		private bool TraverseModel(CancellationToken cancellationToken)
 		{
 			Reset();
 			Context.Output?.WriteLine($"State vector of transition modifiers vector has {_workers.First().TraversalModifierStateVectorSize} bytes."); // valid only after Reset()
 
-			_workers[0].ComputeInitialStates();
-			if (_loadBalancer.IsTerminated)
-				return;
+			// The registration must happen after the reset, as the load balancer would otherwise forget about a prior cancellation;
+			// a cancellation after the traversal has already terminated, e.g. because of a violation, does not cut it short
+			var canceled = false;
+			using (cancellationToken.Register(() =>
+			{
+				canceled = !_loadBalancer.IsTerminated;
+				_loadBalancer.Terminate();
+			}))
+			{
+				_workers[0].ComputeInitialStates();
+				if (!_loadBalancer.IsTerminated)
+				{
+					var tasks = new Task[_workers.Length];
+					for (var i = 0; i < _workers.Length; ++i)
+						tasks[i] = Task.Factory.StartNew(_workers[i].Check);
 
-			var tasks = new Task[_workers.Length];
-			for (var i = 0; i < _workers.Length; ++i)
-				tasks[i] = Task.Factory.StartNew(_workers[i].Check);
+					Task.WaitAll(tasks);
+				}
+			}
 
-			Task.WaitAll(tasks);
+			return !canceled;
 		}
 
 
@@ -135,6 +150,16 @@ namespace ISSE.SafetyChecking.AnalysisModelTraverser
 		///   Traverses the model.
 		/// </summary>
 		public void TraverseModelAndReport()
+		{
+			TraverseModelAndReport(CancellationToken.None);
+		}
+
+		/// <summary>
+		///   Traverses the model, terminating the traversal early and throwing an <see cref="OperationCanceledException" /> when
+		///   the <paramref name="cancellationToken" /> is canceled before the traversal is complete.
+		/// </summary>
+		/// <param name="cancellationToken">The token that can be used to terminate the traversal early.</param>
+		public void TraverseModelAndReport(CancellationToken cancellationToken)
 		{
 			Requires.That(IntPtr.Size == 8, "Model traversal is only supported in 64bit processes.");
 
@@ -149,9 +174,12 @@ namespace ISSE.SafetyChecking.AnalysisModelTraverser
 
 			try
 			{
-				TraverseModel();
+				var completed = TraverseModel(cancellationToken);
 				RethrowTraversalException();
 
+				if (!completed)
+					throw new OperationCanceledException(cancellationToken);
+
 				if (!Context.Configuration.ProgressReportsOnly)
 					Context.Report();
 			}
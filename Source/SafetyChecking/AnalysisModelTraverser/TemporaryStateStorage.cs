@@ -55,7 +55,9 @@ namespace ISSE.SafetyChecking.AnalysisModelTraverser
 
 		private readonly MemoryBuffer _targetStateBuffer = new MemoryBuffer();
 
-		private readonly long _capacity;
+		private readonly long _maximumCapacity;
+
+		private long _capacity;
 
 		private byte* _specialAddress1;
 
@@ -68,15 +70,33 @@ namespace ISSE.SafetyChecking.AnalysisModelTraverser
 		/// <param name="analysisModelStateVectorSize">The length in bytes of a state vector required for the analysis model.</param>
 		/// <param name="capacity">The maximum number of successors that can be cached.</param>
 		public TemporaryStateStorage(int analysisModelStateVectorSize, long capacity)
+			: this(analysisModelStateVectorSize, capacity, capacity)
 		{
-			Requires.That(capacity <= (1 << 30), nameof(capacity), $"Maximum supported capacity is {1 << 30}.");
+		}
+
+		/// <summary>
+		///   Initializes a new instance.
+		/// </summary>
+		/// <param name="analysisModelStateVectorSize">The length in bytes of a state vector required for the analysis model.</param>
+		/// <param name="initialCapacity">The number of successors that can be cached before the storage has to grow.</param>
+		/// <param name="maximumCapacity">The maximum number of successors that can be cached.</param>
+		public TemporaryStateStorage(int analysisModelStateVectorSize, long initialCapacity, long maximumCapacity)
+		{
+			Requires.That(maximumCapacity <= (1 << 30), nameof(maximumCapacity), $"Maximum supported capacity is {1 << 30}.");
+			Requires.That(initialCapacity <= maximumCapacity, nameof(initialCapacity), "The initial capacity exceeds the maximum capacity.");
 
 			AnalysisModelStateVectorSize = analysisModelStateVectorSize;
-			_capacity = capacity;
+			_capacity = initialCapacity;
+			_maximumCapacity = maximumCapacity;
 
 			ResizeStateBuffer();
 		}
 
+		/// <summary>
+		///   Gets the number of successors that can currently be cached.
+		/// </summary>
+		public long Capacity => _capacity;
+
 		/// <summary>
 		///   Get temporal address. This address is not found by TryToFindState and may be used
 		///   inside a method for any purpose. Note, that this address should not leave the scope
@@ -96,7 +116,7 @@ namespace ISSE.SafetyChecking.AnalysisModelTraverser
 		public byte* GetFreeTemporalSpaceAddress()
 		{
 			if (_temporalStates >= _capacity)
-				throw new OutOfMemoryException("Unable to store an additional temporal state. Try increasing the successor state capacity.");
+				throw new SuccessorCapacityExceededException("Unable to store an additional temporal state. Try increasing the successor state capacity.");
 			
 			var successorState = _targetStateMemory + _stateVectorSize * _temporalStates;
 			
@@ -105,6 +125,18 @@ namespace ISSE.SafetyChecking.AnalysisModelTraverser
 			return successorState;
 		}
 
+		/// <summary>
+		///   Returns the address most recently obtained from <see cref="GetFreeTemporalSpaceAddress" /> to the storage, zeroing the
+		///   state stored there so that it can be reused for the next state.
+		/// </summary>
+		internal void ReleaseLastTemporalSpace()
+		{
+			Requires.That(_temporalStates > 0, "No temporal space has been obtained.");
+
+			--_temporalStates;
+			MemoryBuffer.ZeroMemoryWithInitblk.ClearWithZero(_targetStateMemory + _stateVectorSize * _temporalStates, _stateVectorSize);
+		}
+
 		public bool TryToFindState(byte *stateToFind, out byte* foundState)
 		{
 			for (var i = 0; i < _temporalStates; i++)
@@ -138,6 +170,21 @@ namespace ISSE.SafetyChecking.AnalysisModelTraverser
 			_targetStateMemory = _targetStateBuffer.Pointer + _stateVectorSize;
 		}
 
+		/// <summary>
+		///   Doubles the capacity of the storage, invalidating all addresses previously returned by the storage. Returns <c>false</c>
+		///   if the storage already has its maximum capacity.
+		/// </summary>
+		internal bool Grow()
+		{
+			if (_capacity >= _maximumCapacity)
+				return false;
+
+			_capacity = Math.Min(_capacity * 2, _maximumCapacity);
+			ResizeStateBuffer();
+
+			return true;
+		}
+
 		/// <summary>
 		///   Clears the cache, removing all cached states.
 		/// </summary>
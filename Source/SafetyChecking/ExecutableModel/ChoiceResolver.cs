@@ -43,6 +43,22 @@ namespace ISSE.SafetyChecking.ExecutableModel
 		/// </summary>
 		internal bool UseForwardOptimization { get; }
 
+		/// <summary>
+		///   Gets or sets the maximum number of faults that may be activated nondeterministically on a single path, i.e., within a
+		///   single step, or <c>null</c> if the number is unlimited. Faults that remain active from earlier steps are not counted.
+		/// </summary>
+		internal int? LimitOfActiveFaults { get; set; }
+
+		/// <summary>
+		///   Gets or sets the number of faults that have been activated nondeterministically on the current path.
+		/// </summary>
+		internal int ActivatedFaultCount { get; set; }
+
+		/// <summary>
+		///   Gets a value indicating whether no further faults may be activated on the current path.
+		/// </summary>
+		internal bool IsFaultActivationLimitReached => ActivatedFaultCount >= LimitOfActiveFaults;
+
 		/// <summary>
 		///   Initializes a new instance.
 		/// </summary>
@@ -56,6 +56,7 @@ namespace ISSE.SafetyChecking.ExecutableModel
 		public virtual void Save(ExecutableCounterExample<TExecutableModel> counterExample, string file)
 		{
 			Requires.NotNullOrWhitespace(file, nameof(file));
+			Requires.That(counterExample.RuntimeModel.SerializedModel != null, "The serialized model is unavailable, so the counter example cannot be saved.");
 
 			if (!file.EndsWith(FileExtension))
 				file += FileExtension;
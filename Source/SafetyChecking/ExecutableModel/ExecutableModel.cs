@@ -102,7 +102,7 @@ namespace ISSE.SafetyChecking.ExecutableModel
 		
 
 		/// <summary>
-		///   Gets the buffer the model was deserialized from.
+		///   Gets the buffer the model was deserialized from, or <c>null</c> if the model was not deserialized from a buffer.
 		/// </summary>
 		public byte[] SerializedModel { get; set; }
 		
@@ -199,6 +199,10 @@ namespace ISSE.SafetyChecking.ExecutableModel
 		[MethodImpl(MethodImplOptions.AggressiveInlining)]
 		internal void Serialize(byte* serializedState)
 		{
+			// The state header is cleared so that the serialized states can be handed to external tools as-is
+			for (var i = 0; i < StateHeaderBytes; ++i)
+				serializedState[i] = 0;
+
 			_serialize(serializedState + StateHeaderBytes);
 		}
 
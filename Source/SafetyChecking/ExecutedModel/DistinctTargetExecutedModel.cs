@@ -0,0 +1,173 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace ISSE.SafetyChecking.ExecutedModel
+{
+	using System;
+	using System.Linq;
+	using AnalysisModel;
+	using ExecutableModel;
+	using Formula;
+	using Modeling;
+	using Utilities;
+
+	/// <summary>
+	///   Represents an <see cref="AnalysisModel" /> that computes its state by executing a model, generating one transition for each
+	///   distinct target state and fault class, i.e., for the transitions activating no faults, the same single fault, or more than
+	///   one fault. In contrast to the activation-minimal model, the fault sets activated by transitions leading to the same target
+	///   state are not tracked, so the model only provides set-of-targets semantics; it is sufficient whenever the activated faults
+	///   of the individual transitions are irrelevant, e.g., when checking invariants or LTL formulas.
+	/// </summary>
+	internal sealed class DistinctTargetExecutedModel<TExecutableModel> : ExecutedModel<TExecutableModel> where TExecutableModel : ExecutableModel<TExecutableModel>
+	{
+		private readonly Func<bool>[] _stateConstraints;
+		private readonly DistinctTargetTransitionSetBuilder<TExecutableModel> _transitions;
+		private readonly bool _allowFaultsOnInitialTransitions;
+
+		/// <summary>
+		///   Initializes a new instance.
+		/// </summary>
+		/// <param name="runtimeModelCreator">A factory function that creates the model instance that should be executed.</param>
+		/// <param name="formulas">The formulas that should be evaluated for each state.</param>
+		/// <param name="configuration">The analysis configuration that should be used.</param>
+		/// <param name="stateHeaderBytes">
+		///   The number of bytes that should be reserved at the beginning of each state vector for the model checker tool.
+		/// </param>
+		internal DistinctTargetExecutedModel(CoupledExecutableModelCreator<TExecutableModel> runtimeModelCreator, int stateHeaderBytes, Func<bool>[] formulas, AnalysisConfiguration configuration)
+			: base(runtimeModelCreator, stateHeaderBytes, configuration)
+		{
+			formulas = formulas ?? RuntimeModel.Formulas.Select(formula => FormulaCompilationVisitor<TExecutableModel>.Compile(RuntimeModel, formula)).ToArray();
+
+			_transitions = new DistinctTargetTransitionSetBuilder<TExecutableModel>(TemporaryStateStorage, TemporaryStateStorage.Capacity, formulas);
+			_stateConstraints = RuntimeModel.StateConstraints;
+
+			ChoiceResolver = new NondeterministicChoiceResolver(configuration.EnableStaticPruningOptimization)
+			{
+				LimitOfActiveFaults = configuration.LimitOfActiveFaults
+			};
+			FaultSet.CheckFaultCount(RuntimeModel.Faults.Length);
+
+			RuntimeModel.SetChoiceResolver(ChoiceResolver);
+
+			_allowFaultsOnInitialTransitions = configuration.AllowFaultsOnInitialTransitions;
+		}
+
+		/// <summary>
+		///   Gets the size of a single transition of the model in bytes.
+		/// </summary>
+		public override unsafe int TransitionSize => sizeof(CandidateTransition);
+
+		public override Formula[] Formulas => RuntimeModel.Formulas;
+
+		/// <summary>
+		///   Disposes the object, releasing all managed and unmanaged resources.
+		/// </summary>
+		/// <param name="disposing">If true, indicates that the object is disposed; otherwise, the object is finalized.</param>
+		protected override void OnDisposing(bool disposing)
+		{
+			if (disposing)
+				_transitions.SafeDispose();
+
+			base.OnDisposing(disposing);
+		}
+
+		/// <summary>
+		///   Grows the buffers the successor states are computed into, discarding their current contents. Returns <c>false</c> if
+		///   the buffers already have their maximum capacity.
+		/// </summary>
+		protected override bool GrowSuccessorCapacity()
+		{
+			if (!base.GrowSuccessorCapacity())
+				return false;
+
+			_transitions.Resize(TemporaryStateStorage.Capacity);
+			return true;
+		}
+
+		/// <summary>
+		///   Executes an initial transition of the model.
+		/// </summary>
+		protected override void ExecuteInitialTransition()
+		{
+			foreach (var fault in RuntimeModel.NondeterministicFaults)
+				fault.Reset();
+
+			if (!_allowFaultsOnInitialTransitions)
+			{
+				foreach (var fault in RuntimeModel.NondeterministicFaults)
+					fault.Activation = Activation.Suppressed;
+			}
+
+			RuntimeModel.ExecuteInitialStep();
+
+			if (!_allowFaultsOnInitialTransitions)
+			{
+				for (var i = 0; i < RuntimeModel.NondeterministicFaults.Length; i++)
+					RuntimeModel.NondeterministicFaults[i].RestoreActivation(SavedActivations[i]);
+			}
+		}
+
+		/// <summary>
+		///   Executes a transition of the model.
+		/// </summary>
+		protected override void ExecuteTransition()
+		{
+			foreach (var fault in RuntimeModel.NondeterministicFaults)
+				fault.Reset();
+
+			RuntimeModel.ExecuteStep();
+		}
+
+		/// <summary>
+		///   Generates a transition from the model's current state.
+		/// </summary>
+		protected override void GenerateTransition()
+		{
+			// Ignore transitions leading to a state with one or more violated state constraints
+			foreach (var constraint in _stateConstraints)
+			{
+				if (!constraint())
+					return;
+			}
+
+			_transitions.Add(RuntimeModel);
+		}
+
+		/// <summary>
+		///   Invoked before the execution of the next step is started on the model, i.e., before a set of initial
+		///   states or successor states is computed.
+		/// </summary>
+		protected override void BeginExecution()
+		{
+			_transitions.Clear();
+			TemporaryStateStorage.Clear();
+		}
+
+		/// <summary>
+		///   Invoked after the execution of a step is completed on the model, i.e., after a set of initial
+		///   states or successor states have been computed.
+		/// </summary>
+		protected override TransitionCollection EndExecution()
+		{
+			return _transitions.ToCollection();
+		}
+	}
+}
@@ -0,0 +1,200 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace ISSE.SafetyChecking.ExecutedModel
+{
+	using System;
+	using System.Runtime.CompilerServices;
+	using AnalysisModel;
+	using AnalysisModelTraverser;
+	using ExecutableModel;
+	using Utilities;
+
+	/// <summary>
+	///   Creates a set of <see cref="CandidateTransition" /> instances with pairwise distinct target states per fault class, without
+	///   tracking the activation-minimal fault sets of the target states. The transitions activating no faults, the transitions
+	///   activating the same single fault, and the transitions activating more than one fault each form a class of their own; of
+	///   all transitions of a class leading to the same target state, only the one activating the fewest faults is kept.
+	/// </summary>
+	/// <remarks>
+	///   Transitions of different classes are never merged, so whether a transition of a class is kept only depends on the
+	///   transitions of the same class. LtsMin's S# plugin relies on that, as it exports each class as a transition group whose
+	///   dependencies are determined independently of all other groups.
+	/// </remarks>
+	internal sealed unsafe class DistinctTargetTransitionSetBuilder<TExecutableModel> : DisposableObject
+		where TExecutableModel : ExecutableModel<TExecutableModel>
+	{
+		private readonly Func<bool>[] _formulas;
+		private readonly MemoryBuffer _lookupBuffer = new MemoryBuffer();
+		private readonly MemoryBuffer _slotBuffer = new MemoryBuffer();
+		private readonly int _stateVectorSize;
+		private readonly TemporaryStateStorage _temporalStateStorage;
+		private readonly MemoryBuffer _transitionBuffer = new MemoryBuffer();
+		private long _capacity;
+		private int _computedCount;
+		private int _count;
+		private int* _lookup;
+		private long _lookupSize;
+		private long* _slots;
+		private CandidateTransition* _transitions;
+
+		/// <summary>
+		///   Initializes a new instance.
+		/// </summary>
+		/// <param name="temporalStateStorage">A storage where temporal states can be saved to.</param>
+		/// <param name="capacity">The maximum number of successors that can be cached.</param>
+		/// <param name="formulas">The formulas that should be checked for all successor states.</param>
+		public DistinctTargetTransitionSetBuilder(TemporaryStateStorage temporalStateStorage, long capacity, params Func<bool>[] formulas)
+		{
+			Requires.NotNull(temporalStateStorage, nameof(temporalStateStorage));
+			Requires.NotNull(formulas, nameof(formulas));
+			Requires.That(formulas.Length < 32, "At most 32 formulas are supported.");
+
+			_temporalStateStorage = temporalStateStorage;
+			_stateVectorSize = temporalStateStorage.AnalysisModelStateVectorSize;
+			_formulas = formulas;
+
+			Resize(capacity);
+		}
+
+		/// <summary>
+		///   Resizes the set so that it can hold up to <paramref name="capacity" /> transitions, removing all cached states.
+		/// </summary>
+		/// <param name="capacity">The maximum number of successors that can be cached.</param>
+		public void Resize(long capacity)
+		{
+			Requires.That(capacity <= (1 << 30), nameof(capacity), $"Maximum supported capacity is {1 << 30}.");
+
+			// The hash table has twice as many slots as there can be transitions, so there always is an empty slot
+			_lookupSize = capacity * 2;
+
+			_transitionBuffer.Resize(capacity * sizeof(CandidateTransition), zeroMemory: false);
+			_slotBuffer.Resize(capacity * sizeof(long), zeroMemory: false);
+			_lookupBuffer.Resize(_lookupSize * sizeof(int), zeroMemory: false);
+
+			_transitions = (CandidateTransition*)_transitionBuffer.Pointer;
+			_slots = (long*)_slotBuffer.Pointer;
+			_lookup = (int*)_lookupBuffer.Pointer;
+			_capacity = capacity;
+
+			for (var i = 0; i < _lookupSize; ++i)
+				_lookup[i] = -1;
+
+			_count = 0;
+			_computedCount = 0;
+		}
+
+		/// <summary>
+		///   Adds a transition to the <paramref name="model" />'s current state.
+		/// </summary>
+		/// <param name="model">The model the transition should be added for.</param>
+		public void Add(ExecutableModel<TExecutableModel> model)
+		{
+			++_computedCount;
+
+			// Fault activation notifications are executed right away, as only the actual target state is of interest
+			var successorState = _temporalStateStorage.GetFreeTemporalSpaceAddress();
+			var activatedFaults = FaultSet.FromActivatedFaults(model.NondeterministicFaults);
+
+			model.NotifyFaultActivations();
+			model.Serialize(successorState);
+
+			var faultClass = GetFaultClass(activatedFaults);
+			var slot = (long)(MemoryBuffer.Hash(successorState, _stateVectorSize, 0) % (ulong)_lookupSize);
+			while (_lookup[slot] != -1)
+			{
+				var transition = &_transitions[_lookup[slot]];
+				if (GetFaultClass(transition->ActivatedFaults) == faultClass &&
+					MemoryBuffer.AreEqual(successorState, transition->TargetStatePointer, _stateVectorSize))
+				{
+					if (activatedFaults.Cardinality < transition->ActivatedFaults.Cardinality)
+						transition->ActivatedFaults = activatedFaults;
+
+					// The state is already known, so its temporal space can be reused for the next successor
+					_temporalStateStorage.ReleaseLastTemporalSpace();
+					return;
+				}
+
+				slot = (slot + 1) % _lookupSize;
+			}
+
+			if (_count >= _capacity)
+				throw new SuccessorCapacityExceededException("Unable to store an additional transition. Try increasing the successor state capacity.");
+
+			_transitions[_count] = new CandidateTransition
+			{
+				TargetStatePointer = successorState,
+				Formulas = new StateFormulaSet(_formulas),
+				ActivatedFaults = activatedFaults,
+				Flags = TransitionFlags.IsValidFlag,
+			};
+
+			_lookup[slot] = _count;
+			_slots[_count] = slot;
+			++_count;
+		}
+
+		/// <summary>
+		///   Gets the class of transitions activating the <paramref name="faults" />. Sets of at most one fault form a class of their
+		///   own, whereas all sets of more than one fault share a single class.
+		/// </summary>
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		private static long GetFaultClass(FaultSet faults)
+		{
+			return (faults._faults & (faults._faults - 1)) == 0 ? faults._faults : -1;
+		}
+
+		/// <summary>
+		///   Clears the cache, removing all cached states.
+		/// </summary>
+		[MethodImpl(MethodImplOptions.AggressiveInlining)]
+		public void Clear()
+		{
+			for (var i = 0; i < _count; ++i)
+				_lookup[_slots[i]] = -1;
+
+			_count = 0;
+			_computedCount = 0;
+		}
+
+		/// <summary>
+		///   Disposes the object, releasing all managed and unmanaged resources.
+		/// </summary>
+		/// <param name="disposing">If true, indicates that the object is disposed; otherwise, the object is finalized.</param>
+		protected override void OnDisposing(bool disposing)
+		{
+			if (!disposing)
+				return;
+
+			_transitionBuffer.SafeDispose();
+			_slotBuffer.SafeDispose();
+			_lookupBuffer.SafeDispose();
+		}
+
+		/// <summary>
+		///   Creates a <see cref="TransitionCollection" /> instance for all transitions contained in the set.
+		/// </summary>
+		public TransitionCollection ToCollection()
+		{
+			return new TransitionCollection((Transition*)_transitions, _count, _computedCount, sizeof(CandidateTransition));
+		}
+	}
+}
@@ -65,6 +65,12 @@ namespace ISSE.SafetyChecking.ExecutedModel
 		/// </summary>
 		protected Activation[] SavedActivations { get; private set; }
 
+		/// <summary>
+		///   Raised whenever the state of the <see cref="RuntimeModel" /> is about to be changed by the execution of a step or by a
+		///   reset, i.e., whenever the model's fields no longer reflect the state the model was last deserialized from.
+		/// </summary>
+		internal event Action RuntimeModelStateChanged;
+
 		/// <summary>
 		///   Initializes a new instance.
 		/// </summary>
@@ -81,7 +87,7 @@ namespace ISSE.SafetyChecking.ExecutedModel
 			var runtimeModel = createModel.Create(stateHeaderBytes);
 			RuntimeModel = runtimeModel;
 
-			TemporaryStateStorage = new TemporaryStateStorage(ModelStateVectorSize, configuration.SuccessorCapacity);
+			TemporaryStateStorage = new TemporaryStateStorage(ModelStateVectorSize, configuration.InitialSuccessorCapacity, configuration.SuccessorCapacity);
 			SavedActivations = runtimeModel.NondeterministicFaults.Select(fault => fault.Activation).ToArray();
 		}
 
@@ -144,46 +150,106 @@ namespace ISSE.SafetyChecking.ExecutedModel
 		/// </summary>
 		protected abstract TransitionCollection EndExecution();
 
+		/// <summary>
+		///   Grows the buffers the successor states are computed into, discarding their current contents. Returns <c>false</c> if
+		///   the buffers already have their maximum capacity.
+		/// </summary>
+		protected virtual bool GrowSuccessorCapacity()
+		{
+			return TemporaryStateStorage.Grow();
+		}
+
 		/// <summary>
 		///   Gets all initial transitions of the model.
 		/// </summary>
 		public override TransitionCollection GetInitialTransitions()
 		{
-			BeginExecution();
-			ChoiceResolver.PrepareNextState();
-
-			fixed (byte* state = RuntimeModel.ConstructionState)
+			while (true)
 			{
-				while (ChoiceResolver.PrepareNextPath())
+				try
 				{
-					RuntimeModel.Deserialize(state);
-					ExecuteInitialTransition();
+					BeginExecution();
+					ChoiceResolver.PrepareNextState();
+					RuntimeModelStateChanged?.Invoke();
+
+					fixed (byte* state = RuntimeModel.ConstructionState)
+					{
+						while (ChoiceResolver.PrepareNextPath())
+						{
+							ChoiceResolver.ActivatedFaultCount = 0;
+							RuntimeModel.Deserialize(state);
+							ExecuteInitialTransition();
 
-					GenerateTransition();
+							GenerateTransition();
+						}
+					}
+
+					return EndExecution();
 				}
-			}
+				catch (SuccessorCapacityExceededException)
+				{
+					if (!GrowSuccessorCapacity())
+						throw;
 
-			return EndExecution();
+					ChoiceResolver.Clear();
+				}
+			}
 		}
 
 		/// <summary>
-		///   Gets all transitions towards successor states of <paramref name="state" />.
+		///   Gets all transitions towards successor states of <paramref name="state" />. If the successors do not fit into the
+		///   successor buffers, the buffers are grown and the successors are computed again; the addresses contained in the
+		///   returned transitions therefore remain valid until the next transitions are computed.
 		/// </summary>
 		/// <param name="state">The state the successors should be returned for.</param>
 		public override TransitionCollection GetSuccessorTransitions(byte* state)
 		{
-			BeginExecution();
-			ChoiceResolver.PrepareNextState();
+			return GetSuccessorTransitions(state, isStateDeserialized: false);
+		}
 
-			while (ChoiceResolver.PrepareNextPath())
+		/// <summary>
+		///   Gets all transitions towards successor states of <paramref name="state" />. If the successors do not fit into the
+		///   successor buffers, the buffers are grown and the successors are computed again; the addresses contained in the
+		///   returned transitions therefore remain valid until the next transitions are computed.
+		/// </summary>
+		/// <param name="state">The state the successors should be returned for.</param>
+		/// <param name="isStateDeserialized">
+		///   Indicates whether the <see cref="RuntimeModel" /> has already been deserialized from <paramref name="state" /> and has
+		///   not been changed since, in which case the state is not deserialized again before the first step is executed.
+		/// </param>
+		internal TransitionCollection GetSuccessorTransitions(byte* state, bool isStateDeserialized)
+		{
+			while (true)
 			{
-				RuntimeModel.Deserialize(state);
-				ExecuteTransition();
+				try
+				{
+					BeginExecution();
+					ChoiceResolver.PrepareNextState();
+					RuntimeModelStateChanged?.Invoke();
 
-				GenerateTransition();
-			}
+					while (ChoiceResolver.PrepareNextPath())
+					{
+						ChoiceResolver.ActivatedFaultCount = 0;
+
+						if (!isStateDeserialized)
+							RuntimeModel.Deserialize(state);
 
-			return EndExecution();
+						isStateDeserialized = false;
+						ExecuteTransition();
+
+						GenerateTransition();
+					}
+
+					return EndExecution();
+				}
+				catch (SuccessorCapacityExceededException)
+				{
+					if (!GrowSuccessorCapacity())
+						throw;
+
+					ChoiceResolver.Clear();
+				}
+			}
 		}
 
 		/// <summary>
@@ -209,6 +275,7 @@ namespace ISSE.SafetyChecking.ExecutedModel
 		public sealed override void Reset(int traversalModifierStateVectorSize)
 		{
 			ChoiceResolver.Clear();
+			RuntimeModelStateChanged?.Invoke();
 			RuntimeModel.Reset();
 			TemporaryStateStorage.Reset(traversalModifierStateVectorSize);
 
@@ -68,12 +68,15 @@ namespace ISSE.SafetyChecking.FaultMinimalKripkeStructure
 		{
 			formulas = formulas ?? RuntimeModel.Formulas.Select(formula => FormulaCompilationVisitor<TExecutableModel>.Compile(RuntimeModel,formula)).ToArray();
 
-			_transitions = new ActivationMinimalTransitionSetBuilder<TExecutableModel>(TemporaryStateStorage, configuration.SuccessorCapacity, formulas);
+			_transitions = new ActivationMinimalTransitionSetBuilder<TExecutableModel>(TemporaryStateStorage, TemporaryStateStorage.Capacity, formulas);
 			_stateConstraints = RuntimeModel.StateConstraints;
 
 			var useForwardOptimization = configuration.EnableStaticPruningOptimization;
 
-			ChoiceResolver = new NondeterministicChoiceResolver(useForwardOptimization);
+			ChoiceResolver = new NondeterministicChoiceResolver(useForwardOptimization)
+			{
+				LimitOfActiveFaults = configuration.LimitOfActiveFaults
+			};
 			FaultSet.CheckFaultCount(RuntimeModel.Faults.Length);
 
 			RuntimeModel.SetChoiceResolver(ChoiceResolver);
@@ -100,6 +103,19 @@ namespace ISSE.SafetyChecking.FaultMinimalKripkeStructure
 			base.OnDisposing(disposing);
 		}
 
+		/// <summary>
+		///   Grows the buffers the successor states are computed into, discarding their current contents. Returns <c>false</c> if
+		///   the buffers already have their maximum capacity.
+		/// </summary>
+		protected override bool GrowSuccessorCapacity()
+		{
+			if (!base.GrowSuccessorCapacity())
+				return false;
+
+			_transitions.Resize(TemporaryStateStorage.Capacity);
+			return true;
+		}
+
 		/// <summary>
 		///   Executes an initial transition of the model.
 		/// </summary>
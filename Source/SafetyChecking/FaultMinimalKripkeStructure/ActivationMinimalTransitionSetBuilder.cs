@@ -36,18 +36,18 @@ namespace ISSE.SafetyChecking.FaultMinimalKripkeStructure
 	internal sealed unsafe class ActivationMinimalTransitionSetBuilder<TExecutableModel> : DisposableObject where TExecutableModel : ExecutableModel<TExecutableModel>
 	{
 		private const int ProbeThreshold = 1000;
-		private readonly long _capacity;
-		private readonly FaultSetInfo* _faults;
 		private readonly MemoryBuffer _faultsBuffer = new MemoryBuffer();
 		private readonly Func<bool>[] _formulas;
 		private readonly MemoryBuffer _hashedStateBuffer = new MemoryBuffer();
-		private readonly byte* _hashedStateMemory;
-		private readonly int* _lookup;
 		private readonly MemoryBuffer _lookupBuffer = new MemoryBuffer();
 		private readonly int _stateVectorSize;
-		private readonly List<uint> _successors;
+		private readonly List<uint> _successors = new List<uint>();
 		private readonly MemoryBuffer _transitionBuffer = new MemoryBuffer();
-		private readonly CandidateTransition* _transitions;
+		private long _capacity;
+		private FaultSetInfo* _faults;
+		private byte* _hashedStateMemory;
+		private int* _lookup;
+		private CandidateTransition* _transitions;
 		private int _computedCount;
 		private int _count;
 		private int _nextFaultIndex;
@@ -74,6 +74,17 @@ namespace ISSE.SafetyChecking.FaultMinimalKripkeStructure
 			_stateVectorSize = temporalStateStorage.AnalysisModelStateVectorSize;
 			_formulas = formulas;
 
+			Resize(capacity);
+		}
+
+		/// <summary>
+		///   Resizes the set so that it can hold up to <paramref name="capacity" /> transitions, removing all cached states.
+		/// </summary>
+		/// <param name="capacity">The maximum number of successors that can be cached.</param>
+		public void Resize(long capacity)
+		{
+			Requires.That(capacity <= (1 << 30), nameof(capacity), $"Maximum supported capacity is {1 << 30}.");
+
 			_transitionBuffer.Resize(capacity * sizeof(CandidateTransition), zeroMemory: false);
 			_transitions = (CandidateTransition*)_transitionBuffer.Pointer;
 
@@ -81,7 +92,7 @@ namespace ISSE.SafetyChecking.FaultMinimalKripkeStructure
 			_faultsBuffer.Resize(capacity * sizeof(FaultSetInfo), zeroMemory: false);
 			_hashedStateBuffer.Resize(capacity * _stateVectorSize, zeroMemory: false);
 
-			_successors = new List<uint>();
+			_successors.Clear();
 			_capacity = capacity;
 
 			_lookup = (int*)_lookupBuffer.Pointer;
@@ -90,6 +101,10 @@ namespace ISSE.SafetyChecking.FaultMinimalKripkeStructure
 
 			for (var i = 0; i < capacity; ++i)
 				_lookup[i] = -1;
+
+			_count = 0;
+			_computedCount = 0;
+			_nextFaultIndex = 0;
 		}
 
 		/// <summary>
@@ -99,7 +114,7 @@ namespace ISSE.SafetyChecking.FaultMinimalKripkeStructure
 		public void Add(ExecutableModel<TExecutableModel> model)
 		{
 			if (_count >= _capacity)
-				throw new OutOfMemoryException("Unable to store an additional transition. Try increasing the successor state capacity.");
+				throw new SuccessorCapacityExceededException("Unable to store an additional transition. Try increasing the successor state capacity.");
 
 			++_computedCount;
 
@@ -176,7 +191,7 @@ namespace ISSE.SafetyChecking.FaultMinimalKripkeStructure
 				return UpdateTransitions(stateHash, activatedFaults, faultIndex);
 			}
 
-			throw new OutOfMemoryException(
+			throw new SuccessorCapacityExceededException(
 				"Failed to find an empty hash table slot within a reasonable amount of time. Try increasing the successor state capacity.");
 		}
 
@@ -269,7 +284,7 @@ namespace ISSE.SafetyChecking.FaultMinimalKripkeStructure
 		private void AddFaultMetadata(long stateHash, int nextSet)
 		{
 			if (_nextFaultIndex >= _capacity)
-				throw new OutOfMemoryException("Unable to store an additional transition. Try increasing the successor state capacity.");
+				throw new SuccessorCapacityExceededException("Unable to store an additional transition. Try increasing the successor state capacity.");
 
 			_faults[_nextFaultIndex] = new FaultSetInfo
 			{
@@ -23,6 +23,7 @@
 namespace ISSE.SafetyChecking.FaultMinimalKripkeStructure
 {
 	using System;
+	using System.Threading;
 	using ExecutableModel;
 	using AnalysisModel;
 	using AnalysisModelTraverser;
@@ -52,6 +53,16 @@ namespace ISSE.SafetyChecking.FaultMinimalKripkeStructure
 		///   Checks the invariant encoded into the model created by <paramref name="createModel" />.
 		/// </summary>
 		public InvariantAnalysisResult CheckInvariant(Formula formula)
+		{
+			return CheckInvariant(formula, CancellationToken.None);
+		}
+
+		/// <summary>
+		///   Checks the invariant encoded into the model created by <paramref name="createModel" />. The check is terminated
+		///   early and throws an <see cref="OperationCanceledException" /> when the <paramref name="cancellationToken" /> is
+		///   canceled.
+		/// </summary>
+		public InvariantAnalysisResult CheckInvariant(Formula formula, CancellationToken cancellationToken)
 		{
 			// We have to track the state vector layout here; this will nondeterministically store some model instance of
 			// one of the workers; but since all state vectors are the same, we don't care
@@ -62,7 +73,7 @@ namespace ISSE.SafetyChecking.FaultMinimalKripkeStructure
 
 			using (var checker = new InvariantChecker(createAnalysisModel, Configuration, formula))
 			{
-				var result = checker.Check();
+				var result = checker.Check(cancellationToken);
 				return result;
 			}
 		}
@@ -22,6 +22,7 @@
 
 namespace ISSE.SafetyChecking.AnalysisModel
 {
+	using System;
 	using ExecutableModel;
 
 	/// <summary>
@@ -34,10 +35,27 @@ namespace ISSE.SafetyChecking.AnalysisModel
 		/// </summary>
 		public CounterExample CounterExample { get; internal set; }
 
+		/// <summary>
+		///   Gets the outcome of the analysis, which is <see cref="InvariantVerdict.Unknown" /> if the model checker stopped
+		///   before it could decide whether the analyzed formula holds.
+		/// </summary>
+		public InvariantVerdict Verdict { get; internal set; } = InvariantVerdict.Violated;
+
 		/// <summary>
 		///   Gets a value indicating whether the analyzed formula holds.
 		/// </summary>
-		public bool FormulaHolds { get; internal set; }
+		/// <exception cref="InvalidOperationException">Thrown if the <see cref="Verdict" /> is unknown.</exception>
+		public bool FormulaHolds
+		{
+			get
+			{
+				if (Verdict == InvariantVerdict.Unknown)
+					throw new InvalidOperationException("The model checker stopped before it could decide whether the formula holds.");
+
+				return Verdict == InvariantVerdict.Holds;
+			}
+			internal set { Verdict = value ? InvariantVerdict.Holds : InvariantVerdict.Violated; }
+		}
 
 		/// <summary>
 		///   Gets the number of states checked by the model checker.
@@ -24,6 +24,7 @@ namespace ISSE.SafetyChecking.ExecutedModel
 {
 	using System;
 	using System.Linq;
+	using System.Threading;
 	using ExecutableModel;
 	using AnalysisModel;
 	using AnalysisModelTraverser;
@@ -69,10 +70,20 @@ namespace ISSE.SafetyChecking.ExecutedModel
 		///   Checks whether the model's invariant holds for all states.
 		/// </summary>
 		internal InvariantAnalysisResult Check()
+		{
+			return Check(CancellationToken.None);
+		}
+
+		/// <summary>
+		///   Checks whether the model's invariant holds for all states, throwing an <see cref="OperationCanceledException" /> if
+		///   the check is canceled via the <paramref name="cancellationToken" /> before it completes.
+		/// </summary>
+		/// <param name="cancellationToken">The token that can be used to cancel the check.</param>
+		internal InvariantAnalysisResult Check(CancellationToken cancellationToken)
 		{
 			ModelTraverser.Context.Output.WriteLine("Performing invariant check.");
 
-			ModelTraverser.TraverseModelAndReport();
+			ModelTraverser.TraverseModelAndReport(cancellationToken);
 
 			if (!ModelTraverser.Context.FormulaIsValid && !ModelTraverser.Context.Configuration.ProgressReportsOnly)
 				ModelTraverser.Context.Output.WriteLine("Invariant violation detected.");
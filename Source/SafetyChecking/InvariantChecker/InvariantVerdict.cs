@@ -0,0 +1,45 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace ISSE.SafetyChecking.AnalysisModel
+{
+	/// <summary>
+	///   Describes the outcome of an invariant check.
+	/// </summary>
+	public enum InvariantVerdict
+	{
+		/// <summary>
+		///   Indicates that the invariant is violated.
+		/// </summary>
+		Violated,
+
+		/// <summary>
+		///   Indicates that the invariant holds in all reachable states.
+		/// </summary>
+		Holds,
+
+		/// <summary>
+		///   Indicates that the model checker stopped before it could decide whether the invariant holds, for instance because
+		///   it was canceled or exceeded its time or memory limit.
+		/// </summary>
+		Unknown
+	}
+}
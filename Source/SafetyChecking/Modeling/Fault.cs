@@ -215,6 +215,9 @@ namespace ISSE.SafetyChecking.Modeling
 			_canUndoActivation = false;
 			_activationIsUnknown = true;
 			Choice.Resolver.ForwardUntakenChoicesAtIndex(_choiceIndex);
+
+			if (IsActivated)
+				--Choice.Resolver.ActivatedFaultCount;
 		}
 
 		/// <summary>
@@ -241,6 +244,15 @@ namespace ISSE.SafetyChecking.Modeling
 						_canUndoActivation = false;
 						break;
 					case Activation.Nondeterministic:
+						if (Choice.Resolver.IsFaultActivationLimitReached)
+						{
+							// The choice only has a single option, so the paths' choices can still be replayed without the limit
+							Choice.Resolver.HandleChoice(1);
+							IsActivated = false;
+							_canUndoActivation = false;
+							break;
+						}
+
 						if (_probabilityOfOccurrence != null)
 						{
 							IsActivated = Choice.Choose(new Option<bool>(_probabilityOfOccurrenceComplement, false), new Option<bool>(_probabilityOfOccurrence.Value, true));
@@ -251,6 +263,9 @@ namespace ISSE.SafetyChecking.Modeling
 						}
 						_choiceIndex = Choice.Resolver.LastChoiceIndex;
 						_canUndoActivation = true;
+
+						if (IsActivated)
+							++Choice.Resolver.ActivatedFaultCount;
 						break;
 					default:
 						throw new InvalidOperationException("Unsupported fault activation.");
@@ -24,8 +24,10 @@ namespace ISSE.SafetyChecking.Utilities
 {
 	using System;
 	using System.CodeDom;
+	using System.ComponentModel;
 	using System.Diagnostics;
 	using System.IO;
+	using System.Threading;
 	using System.Threading.Tasks;
 
 	/// <summary>
@@ -80,6 +82,25 @@ namespace ISSE.SafetyChecking.Utilities
 		/// </summary>
 		public int ExitCode => _process?.ExitCode ?? 0;
 
+		/// <summary>
+		///   Gets the number of bytes of physical memory currently used by the process, or 0 if the process is not running.
+		/// </summary>
+		public long WorkingSet
+		{
+			get
+			{
+				try
+				{
+					_process.Refresh();
+					return _process.HasExited ? 0 : _process.WorkingSet64;
+				}
+				catch (InvalidOperationException)
+				{
+					return 0;
+				}
+			}
+		}
+
 		/// <summary>
 		///   Gets or sets the process' working directory.
 		/// </summary>
@@ -102,6 +123,19 @@ namespace ISSE.SafetyChecking.Utilities
 		/// </summary>
 		public void Run()
 		{
+			Run(() => true, Timeout.InfiniteTimeSpan);
+		}
+
+		/// <summary>
+		///   Runs the process, invoking <paramref name="shouldContinue" /> whenever the <paramref name="monitoringInterval" /> has
+		///   elapsed; the process is killed as soon as <paramref name="shouldContinue" /> returns <c>false</c>. Returns <c>false</c>
+		///   if the process has been killed.
+		/// </summary>
+		/// <param name="shouldContinue">The callback that decides whether the process is allowed to continue running.</param>
+		/// <param name="monitoringInterval">The interval between two invocations of <paramref name="shouldContinue" />.</param>
+		public bool Run(Func<bool> shouldContinue, TimeSpan monitoringInterval)
+		{
+			Requires.NotNull(shouldContinue, nameof(shouldContinue));
 			Requires.That(!Running, "The process is already running.");
 
 			Running = true;
@@ -109,10 +143,26 @@ namespace ISSE.SafetyChecking.Utilities
 			{
 				_process.Start();
 
-				using (var processWaiter = Task.Factory.StartNew(() => _process.WaitForExit()))
-				using (var outputReader = Task.Factory.StartNew(() => HandleOutput(_process.StandardOutput)))
-				using (var errorReader = Task.Factory.StartNew(() => HandleOutput(_process.StandardError)))
-					Task.WaitAll(processWaiter, outputReader, errorReader);
+				using (var outputReader = Task.Run(() => HandleOutput(_process.StandardOutput)))
+				using (var errorReader = Task.Run(() => HandleOutput(_process.StandardError)))
+				{
+					var completed = true;
+					while (!_process.WaitForExit((int)monitoringInterval.TotalMilliseconds))
+					{
+						if (shouldContinue())
+							continue;
+
+						Kill();
+						completed = false;
+						break;
+					}
+
+					// The output of a killed process is still read to the end, as the readers only finish once the process has exited
+					_process.WaitForExit();
+					Task.WaitAll(outputReader, errorReader);
+
+					return completed;
+				}
 			}
 			finally
 			{
@@ -120,6 +170,25 @@ namespace ISSE.SafetyChecking.Utilities
 			}
 		}
 
+		/// <summary>
+		///   Kills the process, unless it has already exited.
+		/// </summary>
+		private void Kill()
+		{
+			try
+			{
+				_process.Kill();
+			}
+			catch (InvalidOperationException)
+			{
+				// The process has already exited
+			}
+			catch (Win32Exception)
+			{
+				// The process is already terminating
+			}
+		}
+
 		/// <summary>
 		///   Handles process output.
 		/// </summary>
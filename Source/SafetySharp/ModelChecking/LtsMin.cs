@@ -26,13 +26,17 @@ namespace SafetySharp.Analysis
 	using System.ComponentModel;
 	using System.Diagnostics;
 	using System.IO;
+	using System.Linq;
+	using System.Threading;
 	using Modeling;
 	using Runtime;
 	using Runtime.Serialization;
+	using ISSE.SafetyChecking;
 	using ISSE.SafetyChecking.Formula;
 	using ISSE.SafetyChecking.Utilities;
 	using ISSE.SafetyChecking.ExecutableModel;
 	using ISSE.SafetyChecking.AnalysisModel;
+	using ISSE.SafetyChecking.Modeling;
 
 	/// <summary>
 	///   Represents the LtsMin model checker.
@@ -40,40 +44,251 @@ namespace SafetySharp.Analysis
 	public class LtsMin
 	{
 		/// <summary>
-		///   The unique name of the construction state.
+		///   The unique name of the state slot marking the pseudo initial state that is exported for models with more than one
+		///   initial state; the slot is not exported for other models.
 		/// </summary>
-		internal const string ConstructionStateName = "constructionState259C2EE0D9884B92989DF442BA268E8E";
+		internal const string InitialChoiceSlotName = "initialChoice259C2EE0D9884B92989DF442BA268E8E";
+
+		/// <summary>
+		///   The unique name of the state label that only holds in the pseudo initial state, if any.
+		/// </summary>
+		internal const string InitialChoiceLabelName = "isInitialChoice259C2EE0D9884B92989DF442BA268E8E";
+
+		/// <summary>
+		///   The interval in which the time limit, the memory limit, and cancellation requests are checked while LtsMin is running.
+		/// </summary>
+		private static readonly TimeSpan MonitoringInterval = TimeSpan.FromMilliseconds(250);
 
 		/// <summary>
 		///   Represents the LtsMin process that is currently running.
 		/// </summary>
 		private ExternalProcess _ltsMin;
 
+		/// <summary>
+		///   The statistics of the LtsMin process that is currently running.
+		/// </summary>
+		private LtsMinStatistics _statistics;
+
 		/// <summary>
 		///   Raised when the model checker has written an output. The output is always written to the console by default.
 		/// </summary>
 		public TextWriter Output = Console.Out;
 
+		/// <summary>
+		///   The file the statistics of all LtsMin runs are appended to as comma-separated values, or <c>null</c> if the statistics
+		///   should not be exported. A header line is written when the file is created.
+		/// </summary>
+		public string StatisticsFile;
+
+		/// <summary>
+		///   The maximum number of faults that may be activated nondeterministically within a single step, or <c>null</c> if the
+		///   number is unlimited. Faults that remain active from earlier steps are not counted; see
+		///   <see cref="AnalysisConfiguration.LimitOfActiveFaults" />.
+		/// </summary>
+		public int? LimitOfActiveFaults;
+
+		/// <summary>
+		///   Indicates whether faults may be activated during the initial step.
+		/// </summary>
+		public bool AllowFaultsOnInitialTransitions;
+
+		/// <summary>
+		///   Initializes a new instance.
+		/// </summary>
+		public LtsMin()
+		{
+		}
+
+		/// <summary>
+		///   Initializes a new instance that uses as many worker threads as the <paramref name="configuration" /> allows CPUs and
+		///   restricts fault activations as configured.
+		/// </summary>
+		/// <param name="configuration">The configuration the settings are taken from.</param>
+		public LtsMin(AnalysisConfiguration configuration)
+		{
+			ThreadCount = configuration.CpuCount;
+			LimitOfActiveFaults = configuration.LimitOfActiveFaults;
+			AllowFaultsOnInitialTransitions = configuration.AllowFaultsOnInitialTransitions;
+		}
+
+		/// <summary>
+		///   The LtsMin tool that is used to explore the state space.
+		/// </summary>
+		public LtsMinBackend Backend = LtsMinBackend.Sequential;
+
+		/// <summary>
+		///   The number of worker threads LtsMin uses to explore the state space; only the multi-core tool supports more than one
+		///   worker thread. If more than one thread is requested for the <see cref="LtsMinBackend.Sequential" /> backend, the
+		///   multi-core tool is used instead. The value is ignored by all other backends.
+		/// </summary>
+		public int ThreadCount = 1;
+
+		/// <summary>
+		///   The order in which the enumerative LtsMin tools explore the state space.
+		/// </summary>
+		public LtsMinStrategy Strategy = LtsMinStrategy.Default;
+
+		/// <summary>
+		///   Determines how the enumerative LtsMin tools store the visited states.
+		/// </summary>
+		public LtsMinStateStorage StateStorage = LtsMinStateStorage.Default;
+
+		/// <summary>
+		///   The base-2 logarithm of the size of the hash table the enumerative LtsMin tools store the visited states in, or
+		///   <c>null</c> to use the tool's default size.
+		/// </summary>
+		public int? HashTableSizeExponent;
+
+		/// <summary>
+		///   Indicates whether each state variable of the model is exported to LtsMin as a separate state slot. By default, LtsMin
+		///   operates on the bit-packed state vectors, which are smaller but compress considerably worse. The variables are ordered
+		///   such that variables accessed together are adjacent, which is essential for the <see cref="LtsMinBackend.Symbolic" />
+		///   backend.
+		/// </summary>
+		public bool UseVariableStateLayout;
+
+		/// <summary>
+		///   Indicates whether the nondeterministic faults activated by a transition are exported to LtsMin as edge labels, one
+		///   Boolean label per fault. Without edge labels, transitions to the same target state are merged regardless of the faults
+		///   they activate.
+		/// </summary>
+		public bool ExportFaultLabels;
+
+		/// <summary>
+		///   Indicates whether the LtsMin plugin reports details about the loaded model and its preparation, such as the size of the
+		///   state vector or whether cached model artifacts are reused. Diagnostics explaining why the plugin falls back to a slower
+		///   mode of operation are always reported.
+		/// </summary>
+		public bool ReportModelDetails;
+
+		/// <summary>
+		///   Indicates whether a counter example is generated when a formula is violated. LtsMin writes a trace leading to the
+		///   violation that is converted back to the model's state vectors, so the counter example can be replayed and simulated
+		///   without checking the formula again. Only the <see cref="LtsMinBackend.Sequential" /> and
+		///   <see cref="LtsMinBackend.MultiCore" /> backends generate traces; checks of multiple invariants at once never do.
+		/// </summary>
+		public bool GenerateCounterExample = true;
+
+		/// <summary>
+		///   The maximum wall-clock time a single LtsMin run may take, or <c>null</c> if the time is unlimited. LtsMin is stopped
+		///   once the limit is exceeded, in which case the check is inconclusive.
+		/// </summary>
+		public TimeSpan? TimeLimit;
+
+		/// <summary>
+		///   The maximum amount of physical memory in bytes LtsMin may use, or <c>null</c> if the memory is unlimited. LtsMin is
+		///   stopped once the limit is exceeded, in which case the check is inconclusive.
+		/// </summary>
+		public long? MemoryLimitInBytes;
+
+		/// <summary>
+		///   Gets the backend that is actually used to check models.
+		/// </summary>
+		private LtsMinBackend EffectiveBackend =>
+			Backend == LtsMinBackend.Sequential && ThreadCount > 1 ? LtsMinBackend.MultiCore : Backend;
+
+		/// <summary>
+		///   Gets a value indicating whether a counter example is generated for violated formulas.
+		/// </summary>
+		internal bool GeneratesCounterExamples =>
+			GenerateCounterExample && (EffectiveBackend == LtsMinBackend.Sequential || EffectiveBackend == LtsMinBackend.MultiCore);
+
+		/// <summary>
+		///   Gets the name of the LtsMin executable that is used to check models.
+		/// </summary>
+		private string ExecutableName
+		{
+			get
+			{
+				switch (EffectiveBackend)
+				{
+					case LtsMinBackend.Sequential:
+						return "pins2lts-seq.exe";
+					case LtsMinBackend.MultiCore:
+						return "pins2lts-mc.exe";
+					case LtsMinBackend.Symbolic:
+						return "pins2lts-sym.exe";
+					case LtsMinBackend.Distributed:
+						return "pins2lts-dist.exe";
+					default:
+						throw new InvalidOperationException($"Unknown LtsMin backend '{Backend}'.");
+				}
+			}
+		}
+
+		/// <summary>
+		///   Gets the names of the edge labels representing the activation of the <paramref name="faults" />. The names only
+		///   consist of letters, digits, and underscores and are unique even if some of the faults have the same name.
+		/// </summary>
+		/// <param name="faults">The faults the label names should be returned for.</param>
+		internal static string[] GetFaultLabelNames(Fault[] faults)
+		{
+			Requires.NotNull(faults, nameof(faults));
+
+			var names = new string[faults.Length];
+			for (var i = 0; i < faults.Length; ++i)
+			{
+				var name = new string(faults[i].Name.Select(c => Char.IsLetterOrDigit(c) ? c : '_').ToArray());
+				names[i] = Array.IndexOf(names, name, 0, i) == -1 ? name : $"{name}_{faults[i].Identifier}";
+			}
+
+			return names;
+		}
+
+		/// <summary>
+		///   Opens a session that checks any number of formulas for the model created by <paramref name="createModel" />. The model
+		///   is serialized only once for all checks of the session; the session must be disposed once it is no longer needed.
+		/// </summary>
+		/// <param name="createModel">
+		///   The creator for the model that should be checked; it must have been created for all formulas that are checked within
+		///   the session.
+		/// </param>
+		public LtsMinSession OpenSession(CoupledExecutableModelCreator<SafetySharpRuntimeModel> createModel)
+		{
+			Requires.NotNull(createModel, nameof(createModel));
+			return new LtsMinSession(this, createModel);
+		}
+
 		/// <summary>
 		///   Checks whether the <paramref name="formula" /> holds in all states of the <paramref name="model" />.
 		/// </summary>
 		/// <param name="createModel">The creator for the model that should be checked.</param>
 		/// <param name="invariant">The invariant that should be checked.</param>
 		internal InvariantAnalysisResult CheckInvariant(CoupledExecutableModelCreator<SafetySharpRuntimeModel> createModel, Formula invariant)
+		{
+			return CheckInvariant(createModel, invariant, CancellationToken.None);
+		}
+
+		/// <summary>
+		///   Checks whether the <paramref name="invariant" /> holds in all states of the model. The check is inconclusive if it is
+		///   canceled via the <paramref name="cancellationToken" /> before LtsMin completes it.
+		/// </summary>
+		/// <param name="createModel">The creator for the model that should be checked.</param>
+		/// <param name="invariant">The invariant that should be checked.</param>
+		/// <param name="cancellationToken">The token that can be used to cancel the check.</param>
+		internal LtsMinAnalysisResult CheckInvariant(CoupledExecutableModelCreator<SafetySharpRuntimeModel> createModel, Formula invariant,
+													 CancellationToken cancellationToken)
 		{
 			Requires.NotNull(createModel, nameof(createModel));
 			Requires.NotNull(invariant, nameof(invariant));
-			
-			if (!invariant.IsStateFormula())
-				throw new InvalidOperationException("Invariants must be non-temporal state formulas.");
 
-			var transformationVisitor = new LtsMinLtlTransformer();
-			transformationVisitor.Visit(invariant);
-
-			return Check(createModel,
-				$"--invariant=\"({ConstructionStateName} == 1) || ({transformationVisitor.TransformedFormula})\"");
+			using (var session = OpenSession(createModel))
+				return session.CheckInvariant(invariant, cancellationToken);
 		}
 
+		/// <summary>
+		///   Checks whether the <paramref name="invariants" /> hold in all states of the model, exploring the state space only once.
+		/// </summary>
+		/// <param name="createModel">The creator for the model that should be checked.</param>
+		/// <param name="invariants">The invariants that should be checked.</param>
+		internal InvariantAnalysisResult[] CheckInvariants(CoupledExecutableModelCreator<SafetySharpRuntimeModel> createModel, params Formula[] invariants)
+		{
+			Requires.NotNull(createModel, nameof(createModel));
+			Requires.NotNull(invariants, nameof(invariants));
+
+			using (var session = OpenSession(createModel))
+				return session.CheckInvariants(invariants);
+		}
 
 		/// <summary>
 		///   Checks whether the <paramref name="formula" /> holds in all states of the <paramref name="model" />.
@@ -81,10 +296,52 @@ namespace SafetySharp.Analysis
 		/// <param name="createModel">The creator for the model that should be checked.</param>
 		/// <param name="formula">The formula that should be checked.</param>
 		public InvariantAnalysisResult Check(CoupledExecutableModelCreator<SafetySharpRuntimeModel> createModel, Formula formula)
+		{
+			return Check(createModel, formula, CancellationToken.None);
+		}
+
+		/// <summary>
+		///   Checks whether the <paramref name="formula" /> holds in all states of the model. The check is inconclusive if it is
+		///   canceled via the <paramref name="cancellationToken" /> before LtsMin completes it.
+		/// </summary>
+		/// <param name="createModel">The creator for the model that should be checked.</param>
+		/// <param name="formula">The formula that should be checked.</param>
+		/// <param name="cancellationToken">The token that can be used to cancel the check.</param>
+		public LtsMinAnalysisResult Check(CoupledExecutableModelCreator<SafetySharpRuntimeModel> createModel, Formula formula,
+										  CancellationToken cancellationToken)
 		{
 			Requires.NotNull(createModel, nameof(createModel));
 			Requires.NotNull(formula, nameof(formula));
 
+			using (var session = OpenSession(createModel))
+				return session.Check(formula, cancellationToken);
+		}
+
+		/// <summary>
+		///   Gets the argument passed to LtsMin to check the <paramref name="invariant" />.
+		/// </summary>
+		/// <param name="invariant">The invariant that should be checked.</param>
+		internal static string GetInvariantArgument(Formula invariant)
+		{
+			Requires.NotNull(invariant, nameof(invariant));
+
+			if (!invariant.IsStateFormula())
+				throw new InvalidOperationException("Invariants must be non-temporal state formulas.");
+
+			var transformationVisitor = new LtsMinLtlTransformer();
+			transformationVisitor.Visit(invariant);
+
+			return $"--invariant=\"{transformationVisitor.TransformedFormula}\"";
+		}
+
+		/// <summary>
+		///   Gets the argument passed to LtsMin to check the LTL <paramref name="formula" />.
+		/// </summary>
+		/// <param name="formula">The formula that should be checked.</param>
+		internal static string GetLtlArgument(Formula formula)
+		{
+			Requires.NotNull(formula, nameof(formula));
+
 			var visitor = new IsLtlFormulaVisitor();
 			visitor.Visit(formula);
 
@@ -92,9 +349,11 @@ namespace SafetySharp.Analysis
 				throw new NotSupportedException("CTL model checking is currently not supported with LtsMin.");
 
 			var transformationVisitor = new LtsMinLtlTransformer();
-			transformationVisitor.Visit(new UnaryFormula(formula, UnaryOperator.Next));
-			
-			return Check(createModel, $"--ltl=\"{transformationVisitor.TransformedFormula}\"");
+			transformationVisitor.Visit(formula);
+
+			// The pseudo initial state exported for models with multiple initial states has to be skipped
+			var transformedFormula = transformationVisitor.TransformedFormula;
+			return $"--ltl=\"({InitialChoiceLabelName} && X ({transformedFormula})) || (! {InitialChoiceLabelName} && ({transformedFormula}))\"";
 		}
 
 		/// <summary>
@@ -117,78 +376,269 @@ namespace SafetySharp.Analysis
 		}
 
 		/// <summary>
-		///   Checks whether the <paramref name="formula" /> holds in all states of the <paramref name="model" />.
+		///   Checks the model stored in <paramref name="modelFile" />.
 		/// </summary>
-		/// <param name="createModel">The creator for the model that should be checked.</param>
+		/// <param name="modelFile">The file the serialized model that should be checked is stored in.</param>
+		/// <param name="artifactsDirectory">
+		///   The directory the plugin caches the results of its model preparations in, or <c>null</c> if they should not be cached.
+		/// </param>
 		/// <param name="checkArgument">The argument passed to LtsMin that indicates which kind of check to perform.</param>
-		private InvariantAnalysisResult Check(CoupledExecutableModelCreator<SafetySharpRuntimeModel> createModel, string checkArgument)
+		/// <param name="cancellationToken">The token that can be used to stop LtsMin before it completes the check.</param>
+		/// <param name="traceFile">
+		///   The file LtsMin writes the trace leading to a violation to, or <c>null</c> if no trace should be written.
+		/// </param>
+		internal LtsMinAnalysisResult Check(string modelFile, string artifactsDirectory, string checkArgument, CancellationToken cancellationToken,
+											string traceFile = null)
 		{
 			try
 			{
-				using (var modelFile = new TemporaryFile("ssharp"))
+				try
+				{
+					CreateProcess(modelFile, artifactsDirectory, checkArgument, traceFile);
+					Run(cancellationToken);
+				}
+				catch (Win32Exception e)
 				{
-					File.WriteAllBytes(modelFile.FilePath, RuntimeModelSerializer.Save((ModelBase)createModel.SourceModel, createModel.StateFormulasToCheckInBaseModel));
-
-					try
-					{
-						CreateProcess(modelFile.FilePath, checkArgument);
-						Run();
-					}
-					catch (Win32Exception e)
-					{
-						throw new InvalidOperationException(
-							"Failed to start LTSMin. Ensure that pins2lts-seq.exe can be found by either copying it next " +
-							"to the executing assembly or by adding it to the system path. The required cygwin dependencies " +
-							$"must also be available. The original error message was: {e.Message}", e);
-					}
-
-					var success = InterpretExitCode(_ltsMin.ExitCode);
-					return new InvariantAnalysisResult { FormulaHolds = success };
+					throw new InvalidOperationException(
+						$"Failed to start LTSMin. Ensure that {ExecutableName} can be found by either copying it next " +
+						"to the executing assembly or by adding it to the system path. The required cygwin dependencies " +
+						$"must also be available. The original error message was: {e.Message}", e);
 				}
+
+				// The exit code of a process that has been stopped early carries no meaning
+				var verdict = _statistics.Termination != LtsMinTermination.Completed
+					? InvariantVerdict.Unknown
+					: InterpretExitCode(_ltsMin.ExitCode) ? InvariantVerdict.Holds : InvariantVerdict.Violated;
+
+				ExportStatistics(checkArgument);
+				return new LtsMinAnalysisResult(verdict, _statistics);
 			}
 			finally
 			{
 				_ltsMin = null;
+				_statistics = null;
+			}
+		}
+
+		/// <summary>
+		///   Converts the trace stored in LtsMin's binary <paramref name="traceFile" /> to the comma-separated
+		///   <paramref name="csvFile" />, storing the indices of all values instead of their names.
+		/// </summary>
+		/// <param name="traceFile">The file the trace has been written to by LtsMin.</param>
+		/// <param name="csvFile">The file the converted trace should be written to.</param>
+		internal void ConvertTrace(string traceFile, string csvFile)
+		{
+			Requires.NotNullOrWhitespace(traceFile, nameof(traceFile));
+			Requires.NotNullOrWhitespace(csvFile, nameof(csvFile));
+
+			var printTrace = new ExternalProcess(
+				fileName: "ltsmin-printtrace.exe",
+				commandLineArguments: $"--values=idx \"{traceFile}\" \"{csvFile}\"",
+				outputCallback: output => Output?.WriteLine(output))
+			{
+				WorkingDirectory = Environment.CurrentDirectory
+			};
+
+			try
+			{
+				printTrace.Run();
 			}
+			catch (Win32Exception e)
+			{
+				throw new InvalidOperationException(
+					"Failed to start ltsmin-printtrace.exe, which is required to convert the counter examples generated by LtsMin. " +
+					"Ensure that it can be found next to the LtsMin executables or disable counter example generation. " +
+					$"The original error message was: {e.Message}", e);
+			}
+
+			if (printTrace.ExitCode != 0)
+				throw new InvalidOperationException($"ltsmin-printtrace exited with an unexpected exit code: {printTrace.ExitCode}.");
+		}
+
+		/// <summary>
+		///   Appends the statistics of the current LtsMin run to the <see cref="StatisticsFile" />, if any.
+		/// </summary>
+		/// <param name="checkArgument">The argument passed to LtsMin that indicates which kind of check was performed.</param>
+		private void ExportStatistics(string checkArgument)
+		{
+			if (StatisticsFile == null)
+				return;
+
+			if (!File.Exists(StatisticsFile))
+				File.WriteAllText(StatisticsFile, LtsMinStatistics.CsvHeader + Environment.NewLine);
+
+			File.AppendAllText(StatisticsFile, _statistics.ToCsv(checkArgument) + Environment.NewLine);
 		}
 
 		/// <summary>
 		///   Creates a new <see cref="_ltsMin" /> process instance that checks the <paramref name="modelFile" />.
 		/// </summary>
 		/// <param name="modelFile">The model that should be checked.</param>
+		/// <param name="artifactsDirectory">The directory the plugin caches the results of its model preparations in, if any.</param>
 		/// <param name="checkArgument">The argument passed to LtsMin that indicates which kind of check to perform.</param>
-		private void CreateProcess(string modelFile, string checkArgument)
+		/// <param name="traceFile">The file LtsMin writes the trace leading to a violation to, if any.</param>
+		private void CreateProcess(string modelFile, string artifactsDirectory, string checkArgument, string traceFile)
 		{
 			Requires.That(_ltsMin == null, "An instance of LtsMin is already running.");
+			Requires.That(ThreadCount > 0, "LtsMin requires at least one worker thread.");
+
+			ValidateBackend(checkArgument);
 
 			var loaderAssembly = Path.Combine(Environment.CurrentDirectory, "SafetySharp.LtsMin.dll");
+			var backendArguments = GetBackendArguments();
+			var layoutArgument = UseVariableStateLayout ? " --ssharp-variable-layout" : String.Empty;
+			var faultLabelsArgument = ExportFaultLabels ? " --ssharp-fault-labels" : String.Empty;
+			var verboseArgument = ReportModelDetails ? " --ssharp-verbose" : String.Empty;
+			var artifactsArgument = artifactsDirectory != null ? $" --ssharp-artifacts=\"{artifactsDirectory}\"" : String.Empty;
+			var traceArgument = traceFile != null ? $" --trace=\"{traceFile}\"" : String.Empty;
+
+			// The standard output and error streams are read concurrently
+			var statistics = new LtsMinStatistics();
+			_statistics = statistics;
 
 			_ltsMin = new ExternalProcess(
-				fileName: "pins2lts-seq.exe",
-				commandLineArguments: $"--loader=\"{loaderAssembly}\" \"{modelFile}\" {checkArgument}",
-				outputCallback: output => Output?.WriteLine(output))
+				fileName: ExecutableName,
+				commandLineArguments: $"--loader=\"{loaderAssembly}\" \"{modelFile}\" {checkArgument}{backendArguments}{layoutArgument}{faultLabelsArgument}{verboseArgument}{artifactsArgument}{traceArgument}",
+				outputCallback: output =>
+				{
+					lock (statistics)
+						statistics.Parse(output);
+
+					Output?.WriteLine(output);
+				})
 			{
 				WorkingDirectory = Environment.CurrentDirectory
 			};
 		}
 
 		/// <summary>
-		///   Runs the <see cref="_ltsMin" /> process instance.
+		///   Checks whether the selected backend supports the check requested by <paramref name="checkArgument" /> as well as the
+		///   selected exploration options.
 		/// </summary>
-		private void Run()
+		/// <param name="checkArgument">The argument passed to LtsMin that indicates which kind of check to perform.</param>
+		private void ValidateBackend(string checkArgument)
+		{
+			var backend = EffectiveBackend;
+			var isEnumerative = backend == LtsMinBackend.Sequential || backend == LtsMinBackend.MultiCore;
+
+			// The symbolic and distributed tools do not support LTL; additionally, the plugin can only check multiple invariants
+			// when it is run in a single process that expands all states one by one, which the symbolic tool does not do
+			if (!isEnumerative && checkArgument.StartsWith("--ltl"))
+				throw new NotSupportedException($"LTL model checking is not supported by the '{backend}' LtsMin backend.");
+
+			if (!isEnumerative && checkArgument.StartsWith("--ssharp-invariants"))
+				throw new NotSupportedException($"Checking multiple invariants at once is not supported by the '{backend}' LtsMin backend.");
+
+			if (!isEnumerative && Strategy != LtsMinStrategy.Default)
+				throw new NotSupportedException($"The '{backend}' LtsMin backend does not support exploration strategies.");
+
+			if (!isEnumerative && StateStorage != LtsMinStateStorage.Default)
+				throw new NotSupportedException($"The '{backend}' LtsMin backend does not support state storage selection.");
+
+			if (!isEnumerative && HashTableSizeExponent != null)
+				throw new NotSupportedException($"The '{backend}' LtsMin backend does not support hash table size selection.");
+
+			if (backend != LtsMinBackend.MultiCore && StateStorage == LtsMinStateStorage.ClearyTree)
+				throw new NotSupportedException("The Cleary tree state storage is only supported by the multi-core LtsMin backend.");
+
+			Requires.That(HashTableSizeExponent == null || HashTableSizeExponent > 0, "The hash table size exponent must be positive.");
+			Requires.That(TimeLimit == null || TimeLimit > TimeSpan.Zero, "The time limit must be positive.");
+			Requires.That(MemoryLimitInBytes == null || MemoryLimitInBytes > 0, "The memory limit must be positive.");
+		}
+
+		/// <summary>
+		///   Gets the arguments passed to LtsMin that configure the selected backend.
+		/// </summary>
+		private string GetBackendArguments()
+		{
+			var threadsArgument = EffectiveBackend == LtsMinBackend.MultiCore ? $" --threads={ThreadCount}" : String.Empty;
+			var sizeArgument = HashTableSizeExponent != null ? $" --size={HashTableSizeExponent}" : String.Empty;
+			var strategyArgument = String.Empty;
+			var storageArgument = String.Empty;
+
+			switch (Strategy)
+			{
+				case LtsMinStrategy.BreadthFirst:
+					strategyArgument = " --strategy=bfs";
+					break;
+				case LtsMinStrategy.StrictBreadthFirst:
+					strategyArgument = " --strategy=sbfs";
+					break;
+				case LtsMinStrategy.DepthFirst:
+					strategyArgument = " --strategy=dfs";
+					break;
+			}
+
+			switch (StateStorage)
+			{
+				case LtsMinStateStorage.Table:
+					storageArgument = " --state=table";
+					break;
+				case LtsMinStateStorage.Tree:
+					storageArgument = " --state=tree";
+					break;
+				case LtsMinStateStorage.ClearyTree:
+					storageArgument = " --state=cleary-tree";
+					break;
+			}
+
+			return $"{threadsArgument}{strategyArgument}{storageArgument}{sizeArgument}";
+		}
+
+		/// <summary>
+		///   Runs the <see cref="_ltsMin" /> process instance, stopping it early if the <paramref name="cancellationToken" /> is
+		///   canceled or the configured time or memory limit is exceeded.
+		/// </summary>
+		/// <param name="cancellationToken">The token that can be used to stop the process.</param>
+		private void Run(CancellationToken cancellationToken)
 		{
 			var stopwatch = new Stopwatch();
 			stopwatch.Start();
 
-			_ltsMin.Run();
+			// The process is not started at all if the token has already been canceled; otherwise, a quick run might complete before
+			// the cancellation is noticed for the first time
+			var stopReason = GetStopReason(TimeSpan.Zero, cancellationToken);
+			if (stopReason == null)
+			{
+				_ltsMin.Run(() =>
+				{
+					stopReason = GetStopReason(stopwatch.Elapsed, cancellationToken);
+					return stopReason == null;
+				}, MonitoringInterval);
+			}
 
 			stopwatch.Stop();
+			_statistics.ElapsedTime = stopwatch.Elapsed;
+			_statistics.Termination = stopReason ?? LtsMinTermination.Completed;
 
 			Output?.WriteLine(String.Empty);
 			Output?.WriteLine("=====================================");
 			Output?.WriteLine($"Elapsed time: {stopwatch.Elapsed}");
+
+			if (stopReason != null)
+				Output?.WriteLine($"LtsMin has been stopped early: {stopReason}");
+
 			Output?.WriteLine("=====================================");
 			Output?.WriteLine(String.Empty);
 		}
+
+		/// <summary>
+		///   Gets the reason why the running <see cref="_ltsMin" /> process has to be stopped, or <c>null</c> if it may continue.
+		/// </summary>
+		/// <param name="elapsedTime">The time that has elapsed since the process has been started.</param>
+		/// <param name="cancellationToken">The token that can be used to stop the process.</param>
+		private LtsMinTermination? GetStopReason(TimeSpan elapsedTime, CancellationToken cancellationToken)
+		{
+			if (cancellationToken.IsCancellationRequested)
+				return LtsMinTermination.Canceled;
+
+			if (TimeLimit != null && elapsedTime > TimeLimit)
+				return LtsMinTermination.TimedOut;
+
+			if (MemoryLimitInBytes != null && _ltsMin.WorkingSet > MemoryLimitInBytes)
+				return LtsMinTermination.MemoryLimitExceeded;
+
+			return null;
+		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,66 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace SafetySharp.Analysis
+{
+	using System;
+	using ISSE.SafetyChecking.AnalysisModel;
+	using ISSE.SafetyChecking.Utilities;
+
+	/// <summary>
+	///   Describes the result of a model checking based analysis performed by <see cref="LtsMin" />.
+	/// </summary>
+	public class LtsMinAnalysisResult : InvariantAnalysisResult
+	{
+		/// <summary>
+		///   Initializes a new instance.
+		/// </summary>
+		/// <param name="verdict">The outcome of the analysis.</param>
+		/// <param name="statistics">The statistics of the LtsMin run that performed the analysis.</param>
+		internal LtsMinAnalysisResult(InvariantVerdict verdict, LtsMinStatistics statistics)
+		{
+			Requires.NotNull(statistics, nameof(statistics));
+
+			Verdict = verdict;
+			Statistics = statistics;
+			StateCount = (int)Math.Min(statistics.StateCount ?? 0, Int32.MaxValue);
+			TransitionCount = statistics.TransitionCount ?? 0;
+			LevelCount = statistics.LevelCount ?? 0;
+		}
+
+		/// <summary>
+		///   Gets the statistics of the LtsMin run that performed the analysis.
+		/// </summary>
+		public LtsMinStatistics Statistics { get; }
+
+		/// <summary>
+		///   Gets a value describing how the LtsMin run ended.
+		/// </summary>
+		public LtsMinTermination Termination => Statistics.Termination;
+
+		/// <summary>
+		///   Gets a value indicating whether LtsMin decided whether the formula holds. If the run was canceled or exceeded its time
+		///   or memory limit before a violation was found, the <see cref="InvariantAnalysisResult.Verdict" /> is
+		///   <see cref="InvariantVerdict.Unknown" />.
+		/// </summary>
+		public bool IsConclusive => Verdict != InvariantVerdict.Unknown;
+	}
+}
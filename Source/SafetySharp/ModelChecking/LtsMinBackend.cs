@@ -0,0 +1,50 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace SafetySharp.Analysis
+{
+	/// <summary>
+	///   Determines the LtsMin tool that is used to explore the state space of a model.
+	/// </summary>
+	public enum LtsMinBackend
+	{
+		/// <summary>
+		///   Indicates that the sequential enumerative pins2lts-seq tool is used; if more than one worker thread is requested, the
+		///   multi-core tool is used instead.
+		/// </summary>
+		Sequential,
+
+		/// <summary>
+		///   Indicates that the multi-core enumerative pins2lts-mc tool is used.
+		/// </summary>
+		MultiCore,
+
+		/// <summary>
+		///   Indicates that the symbolic pins2lts-sym tool is used that stores the state space as decision diagrams.
+		/// </summary>
+		Symbolic,
+
+		/// <summary>
+		///   Indicates that the distributed enumerative pins2lts-dist tool is used.
+		/// </summary>
+		Distributed
+	}
+}
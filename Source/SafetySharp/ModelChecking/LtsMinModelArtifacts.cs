@@ -0,0 +1,254 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace SafetySharp.Analysis
+{
+	using System;
+	using System.IO;
+	using System.Linq;
+	using System.Security.Cryptography;
+	using System.Text;
+	using ISSE.SafetyChecking.Utilities;
+	using Runtime;
+	using Runtime.Serialization;
+
+	/// <summary>
+	///   Provides the results of the model preparations LtsMin's S# plugin performs when it loads a model: the model's initial
+	///   states, the programs of the compiled state labels, and the state slots accessed by the transition groups and the state
+	///   labels. As these only depend on the model file and the assemblies the model is loaded from, the plugin stores them in a
+	///   cache directory, so that subsequent LtsMin runs for the same model can skip the preparations.
+	/// </summary>
+	/// <remarks>
+	///   The artifacts are stored in a file named after their key, which identifies the model file's contents as well as the
+	///   assemblies involved; whenever either changes, the key changes as well, so outdated artifacts are never loaded.
+	/// </remarks>
+	internal sealed class LtsMinModelArtifacts
+	{
+		/// <summary>
+		///   The version of the file format, which is part of the key.
+		/// </summary>
+		private const int FormatVersion = 1;
+
+		/// <summary>
+		///   The extension of the files the artifacts are stored in.
+		/// </summary>
+		private const string FileExtension = ".artifacts";
+
+		/// <summary>
+		///   Gets or sets the number of bytes reserved at the beginning of the state vectors.
+		/// </summary>
+		public int StateHeaderBytes { get; set; }
+
+		/// <summary>
+		///   Gets or sets the number of initial states.
+		/// </summary>
+		public int InitialStateCount { get; set; }
+
+		/// <summary>
+		///   Gets or sets the initial states, stored consecutively including their state headers.
+		/// </summary>
+		public byte[] InitialStates { get; set; }
+
+		/// <summary>
+		///   Gets or sets the programs of the compiled state labels, containing <c>null</c> for labels that cannot be compiled.
+		/// </summary>
+		public int[][] LabelPrograms { get; set; }
+
+		/// <summary>
+		///   Gets or sets the state slots accessed by the transition groups, containing <c>null</c> for groups that are not
+		///   analyzed.
+		/// </summary>
+		public StateAccessSet[] GroupAccesses { get; set; }
+
+		/// <summary>
+		///   Gets or sets the state slots accessed by the state labels.
+		/// </summary>
+		public StateAccessSet[] LabelAccesses { get; set; }
+
+		/// <summary>
+		///   Computes the key of the artifacts of the model stored in the <paramref name="modelFile" />.
+		/// </summary>
+		/// <param name="modelFile">The file the model is stored in.</param>
+		/// <param name="objectTable">The objects of the deserialized model.</param>
+		public static string ComputeKey(string modelFile, ObjectTable objectTable)
+		{
+			Requires.NotNullOrWhitespace(modelFile, nameof(modelFile));
+			Requires.NotNull(objectTable, nameof(objectTable));
+
+			// The plugin's results depend on the code of the model's types and on S# itself, which might change without changing
+			// the serialized model; hence, the module versions of all of these assemblies are hashed as well
+			var assemblies = objectTable
+				.Where(obj => obj != null)
+				.Select(obj => obj.GetType().Assembly)
+				.Concat(new[] { typeof(LtsMinModelArtifacts).Assembly, typeof(Requires).Assembly })
+				.Distinct()
+				.Select(assembly => $"{assembly.FullName}|{assembly.ManifestModule.ModuleVersionId}")
+				.OrderBy(assembly => assembly, StringComparer.Ordinal);
+
+			using (var hash = SHA256.Create())
+			using (var stream = new CryptoStream(Stream.Null, hash, CryptoStreamMode.Write))
+			{
+				using (var writer = new BinaryWriter(stream, Encoding.UTF8, leaveOpen: true))
+				{
+					writer.Write(FormatVersion);
+					foreach (var assembly in assemblies)
+						writer.Write(assembly);
+				}
+
+				using (var file = File.OpenRead(modelFile))
+					file.CopyTo(stream);
+
+				stream.FlushFinalBlock();
+				return String.Concat(hash.Hash.Select(b => b.ToString("x2")));
+			}
+		}
+
+		/// <summary>
+		///   Loads the artifacts with the given <paramref name="key" /> from the <paramref name="directory" />. Returns <c>null</c>
+		///   if there are no such artifacts or if they cannot be read.
+		/// </summary>
+		/// <param name="directory">The directory the artifacts are cached in.</param>
+		/// <param name="key">The key of the artifacts that should be loaded.</param>
+		/// <param name="layout">The state vector layout of the model the artifacts belong to.</param>
+		public static LtsMinModelArtifacts Load(string directory, string key, StateVectorLayout layout)
+		{
+			Requires.NotNullOrWhitespace(directory, nameof(directory));
+			Requires.NotNullOrWhitespace(key, nameof(key));
+			Requires.NotNull(layout, nameof(layout));
+
+			var file = Path.Combine(directory, key + FileExtension);
+			if (!File.Exists(file))
+				return null;
+
+			try
+			{
+				using (var reader = new BinaryReader(File.OpenRead(file)))
+				{
+					var artifacts = new LtsMinModelArtifacts
+					{
+						StateHeaderBytes = reader.ReadInt32(),
+						InitialStateCount = reader.ReadInt32(),
+						InitialStates = reader.ReadBytes(reader.ReadInt32()),
+						LabelPrograms = new int[reader.ReadInt32()][]
+					};
+
+					for (var i = 0; i < artifacts.LabelPrograms.Length; ++i)
+					{
+						var length = reader.ReadInt32();
+						if (length != -1)
+							artifacts.LabelPrograms[i] = Enumerable.Range(0, length).Select(_ => reader.ReadInt32()).ToArray();
+					}
+
+					artifacts.GroupAccesses = ReadAccesses(reader, layout);
+					artifacts.LabelAccesses = ReadAccesses(reader, layout);
+
+					return artifacts;
+				}
+			}
+			catch (IOException)
+			{
+				// The cache is only an optimization; if the artifacts cannot be read, they are simply recomputed
+				return null;
+			}
+		}
+
+		/// <summary>
+		///   Stores the artifacts with the given <paramref name="key" /> in the <paramref name="directory" />. The artifacts are
+		///   written to a temporary file first that is renamed afterwards, so concurrent LtsMin runs never read incomplete files.
+		/// </summary>
+		/// <param name="directory">The directory the artifacts should be cached in.</param>
+		/// <param name="key">The key of the artifacts.</param>
+		public void Save(string directory, string key)
+		{
+			Requires.NotNullOrWhitespace(directory, nameof(directory));
+			Requires.NotNullOrWhitespace(key, nameof(key));
+
+			var file = Path.Combine(directory, key + FileExtension);
+			var temporaryFile = Path.Combine(directory, $"{key}.{Guid.NewGuid()}.tmp");
+
+			try
+			{
+				Directory.CreateDirectory(directory);
+
+				using (var writer = new BinaryWriter(File.Create(temporaryFile)))
+				{
+					writer.Write(StateHeaderBytes);
+					writer.Write(InitialStateCount);
+					writer.Write(InitialStates.Length);
+					writer.Write(InitialStates);
+					writer.Write(LabelPrograms.Length);
+
+					foreach (var program in LabelPrograms)
+					{
+						writer.Write(program?.Length ?? -1);
+						foreach (var instruction in program ?? new int[0])
+							writer.Write(instruction);
+					}
+
+					WriteAccesses(writer, GroupAccesses);
+					WriteAccesses(writer, LabelAccesses);
+				}
+
+				// Another LtsMin run might have stored the same artifacts in the meantime, in which case they are kept
+				if (File.Exists(file))
+					File.Delete(temporaryFile);
+				else
+					File.Move(temporaryFile, file);
+			}
+			catch (IOException)
+			{
+				// The cache is only an optimization; if the artifacts cannot be stored, they are recomputed the next time
+			}
+			catch (UnauthorizedAccessException)
+			{
+				// See above
+			}
+		}
+
+		/// <summary>
+		///   Writes the <paramref name="accesses" /> using the <paramref name="writer" />.
+		/// </summary>
+		private static void WriteAccesses(BinaryWriter writer, StateAccessSet[] accesses)
+		{
+			writer.Write(accesses.Length);
+			foreach (var access in accesses)
+			{
+				writer.Write(access != null);
+				access?.Save(writer);
+			}
+		}
+
+		/// <summary>
+		///   Reads state accesses for the <paramref name="layout" /> using the <paramref name="reader" />.
+		/// </summary>
+		private static StateAccessSet[] ReadAccesses(BinaryReader reader, StateVectorLayout layout)
+		{
+			var accesses = new StateAccessSet[reader.ReadInt32()];
+			for (var i = 0; i < accesses.Length; ++i)
+			{
+				if (reader.ReadBoolean())
+					accesses[i] = StateAccessSet.Load(reader, layout);
+			}
+
+			return accesses;
+		}
+	}
+}
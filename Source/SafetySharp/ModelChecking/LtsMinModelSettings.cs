@@ -0,0 +1,163 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace SafetySharp.Analysis
+{
+	using System.Collections.Generic;
+	using System.IO;
+	using System.Linq;
+	using ISSE.SafetyChecking;
+	using ISSE.SafetyChecking.Modeling;
+	using ISSE.SafetyChecking.Utilities;
+	using Runtime;
+
+	/// <summary>
+	///   Provides the analysis settings LtsMin's S# plugin applies to the models it loads. The settings are stored in the model
+	///   file, following the serialized model, and end with their own length, so the plugin can find them from the end of the
+	///   file.
+	/// </summary>
+	internal sealed class LtsMinModelSettings
+	{
+		/// <summary>
+		///   The activations of the model's faults, indexed by the faults' identifiers.
+		/// </summary>
+		private readonly Dictionary<int, Activation> _faultActivations;
+
+		/// <summary>
+		///   Initializes a new instance.
+		/// </summary>
+		/// <param name="limitOfActiveFaults">
+		///   The maximum number of faults that may be activated nondeterministically within a single step, if any.
+		/// </param>
+		/// <param name="allowFaultsOnInitialTransitions">Indicates whether faults may be activated during the initial step.</param>
+		/// <param name="faults">The faults whose current activations should be applied to the loaded models.</param>
+		public LtsMinModelSettings(int? limitOfActiveFaults, bool allowFaultsOnInitialTransitions, IEnumerable<Fault> faults)
+			: this(limitOfActiveFaults, allowFaultsOnInitialTransitions, faults.ToDictionary(fault => fault.Identifier, fault => fault.Activation))
+		{
+		}
+
+		/// <summary>
+		///   Initializes a new instance.
+		/// </summary>
+		private LtsMinModelSettings(int? limitOfActiveFaults, bool allowFaultsOnInitialTransitions, Dictionary<int, Activation> faultActivations)
+		{
+			LimitOfActiveFaults = limitOfActiveFaults;
+			AllowFaultsOnInitialTransitions = allowFaultsOnInitialTransitions;
+			_faultActivations = faultActivations;
+		}
+
+		/// <summary>
+		///   Gets the maximum number of faults that may be activated nondeterministically within a single step, or <c>null</c> if
+		///   the number is unlimited. Faults that remain active from earlier steps are not counted.
+		/// </summary>
+		public int? LimitOfActiveFaults { get; }
+
+		/// <summary>
+		///   Gets a value indicating whether faults may be activated during the initial step.
+		/// </summary>
+		public bool AllowFaultsOnInitialTransitions { get; }
+
+		/// <summary>
+		///   Writes the <paramref name="serializedModel" /> followed by the settings to the <paramref name="modelFile" />.
+		/// </summary>
+		/// <param name="modelFile">The file the model and the settings should be written to.</param>
+		/// <param name="serializedModel">The serialized model that should be written.</param>
+		public void Save(string modelFile, byte[] serializedModel)
+		{
+			Requires.NotNullOrWhitespace(modelFile, nameof(modelFile));
+			Requires.NotNull(serializedModel, nameof(serializedModel));
+
+			using (var stream = File.Create(modelFile))
+			using (var writer = new BinaryWriter(stream))
+			{
+				writer.Write(serializedModel);
+
+				var start = stream.Position;
+				writer.Write(LimitOfActiveFaults ?? -1);
+				writer.Write(AllowFaultsOnInitialTransitions);
+				writer.Write(_faultActivations.Count);
+
+				foreach (var activation in _faultActivations)
+				{
+					writer.Write(activation.Key);
+					writer.Write((int)activation.Value);
+				}
+
+				writer.Write((int)(stream.Position - start));
+			}
+		}
+
+		/// <summary>
+		///   Loads the settings stored in the <paramref name="modelFile" />.
+		/// </summary>
+		/// <param name="modelFile">The file the settings should be loaded from.</param>
+		public static LtsMinModelSettings Load(string modelFile)
+		{
+			Requires.NotNullOrWhitespace(modelFile, nameof(modelFile));
+
+			using (var stream = File.OpenRead(modelFile))
+			using (var reader = new BinaryReader(stream))
+			{
+				stream.Seek(-sizeof(int), SeekOrigin.End);
+				var length = reader.ReadInt32();
+				stream.Seek(-sizeof(int) - length, SeekOrigin.End);
+
+				var limitOfActiveFaults = reader.ReadInt32();
+				var allowFaultsOnInitialTransitions = reader.ReadBoolean();
+				var faultActivations = new Dictionary<int, Activation>();
+
+				var faultCount = reader.ReadInt32();
+				for (var i = 0; i < faultCount; ++i)
+					faultActivations.Add(reader.ReadInt32(), (Activation)reader.ReadInt32());
+
+				return new LtsMinModelSettings(limitOfActiveFaults == -1 ? (int?)null : limitOfActiveFaults,
+					allowFaultsOnInitialTransitions, faultActivations);
+			}
+		}
+
+		/// <summary>
+		///   Returns a copy of the <paramref name="configuration" /> the settings have been applied to.
+		/// </summary>
+		/// <param name="configuration">The configuration the settings should be applied to.</param>
+		public AnalysisConfiguration Apply(AnalysisConfiguration configuration)
+		{
+			configuration.LimitOfActiveFaults = LimitOfActiveFaults;
+			configuration.AllowFaultsOnInitialTransitions = AllowFaultsOnInitialTransitions;
+
+			return configuration;
+		}
+
+		/// <summary>
+		///   Applies the fault activations to the <paramref name="model" />.
+		/// </summary>
+		/// <param name="model">The model the fault activations should be applied to.</param>
+		public void Apply(SafetySharpRuntimeModel model)
+		{
+			Requires.NotNull(model, nameof(model));
+
+			model.ChangeFaultActivations(fault =>
+			{
+				Activation activation;
+				return _faultActivations.TryGetValue(fault.Identifier, out activation) ? activation : fault.Activation;
+			});
+		}
+	}
+}
@@ -0,0 +1,233 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace SafetySharp.Analysis
+{
+	using System;
+	using System.IO;
+	using System.Linq;
+	using System.Threading;
+	using ISSE.SafetyChecking.AnalysisModel;
+	using ISSE.SafetyChecking.ExecutableModel;
+	using ISSE.SafetyChecking.Formula;
+	using ISSE.SafetyChecking.Utilities;
+	using Modeling;
+	using Runtime;
+	using Runtime.Serialization;
+
+	/// <summary>
+	///   Represents a session that checks multiple formulas for the same model with <see cref="LtsMin" />. The model is serialized
+	///   only once when the session is opened; all checks of the session reuse the serialized model. Additionally, LtsMin's S#
+	///   plugin caches the results of its model preparations next to the model file, so only the session's first check has to
+	///   compute the model's initial states, compile its state labels, and analyze its state accesses.
+	/// </summary>
+	public sealed class LtsMinSession : DisposableObject
+	{
+		/// <summary>
+		///   The model checker used to check the formulas.
+		/// </summary>
+		private readonly LtsMin _ltsMin;
+
+		/// <summary>
+		///   The file the serialized model is stored in.
+		/// </summary>
+		private readonly TemporaryFile _modelFile;
+
+		/// <summary>
+		///   The directory the plugin caches the results of its model preparations in.
+		/// </summary>
+		private readonly string _artifactsDirectory;
+
+		/// <summary>
+		///   The creator for the model that is checked.
+		/// </summary>
+		private readonly CoupledExecutableModelCreator<SafetySharpRuntimeModel> _createModel;
+
+		/// <summary>
+		///   The formulas the model has been serialized with.
+		/// </summary>
+		private readonly Formula[] _formulas;
+
+		/// <summary>
+		///   Initializes a new instance.
+		/// </summary>
+		/// <param name="ltsMin">The model checker used to check the formulas.</param>
+		/// <param name="createModel">The creator for the model that should be checked.</param>
+		internal LtsMinSession(LtsMin ltsMin, CoupledExecutableModelCreator<SafetySharpRuntimeModel> createModel)
+		{
+			Requires.NotNull(ltsMin, nameof(ltsMin));
+			Requires.NotNull(createModel, nameof(createModel));
+
+			_ltsMin = ltsMin;
+			_createModel = createModel;
+			_modelFile = new TemporaryFile("ssharp");
+			_artifactsDirectory = Path.ChangeExtension(_modelFile.FilePath, "artifacts");
+			_formulas = createModel.StateFormulasToCheckInBaseModel;
+
+			var serializedModel = RuntimeModelSerializer.Save((ModelBase)createModel.SourceModel, createModel.StateFormulasToCheckInBaseModel);
+			var settings = new LtsMinModelSettings(ltsMin.LimitOfActiveFaults, ltsMin.AllowFaultsOnInitialTransitions, createModel.FaultsInBaseModel);
+			settings.Save(_modelFile.FilePath, serializedModel);
+		}
+
+		/// <summary>
+		///   Checks whether the <paramref name="formula" /> holds in all states of the session's model.
+		/// </summary>
+		/// <param name="formula">The formula that should be checked.</param>
+		public LtsMinAnalysisResult Check(Formula formula)
+		{
+			return Check(formula, CancellationToken.None);
+		}
+
+		/// <summary>
+		///   Checks whether the <paramref name="formula" /> holds in all states of the session's model. The check is inconclusive if
+		///   it is canceled via the <paramref name="cancellationToken" /> before LtsMin completes it.
+		/// </summary>
+		/// <param name="formula">The formula that should be checked.</param>
+		/// <param name="cancellationToken">The token that can be used to cancel the check.</param>
+		public LtsMinAnalysisResult Check(Formula formula, CancellationToken cancellationToken)
+		{
+			Requires.That(!IsDisposed, "The session has already been disposed.");
+			return Check(LtsMin.GetLtlArgument(formula), cancellationToken);
+		}
+
+		/// <summary>
+		///   Checks whether the <paramref name="invariant" /> holds in all states of the session's model.
+		/// </summary>
+		/// <param name="invariant">The invariant that should be checked.</param>
+		public LtsMinAnalysisResult CheckInvariant(Formula invariant)
+		{
+			return CheckInvariant(invariant, CancellationToken.None);
+		}
+
+		/// <summary>
+		///   Checks whether the <paramref name="invariant" /> holds in all states of the session's model. The check is inconclusive
+		///   if it is canceled via the <paramref name="cancellationToken" /> before LtsMin completes it.
+		/// </summary>
+		/// <param name="invariant">The invariant that should be checked.</param>
+		/// <param name="cancellationToken">The token that can be used to cancel the check.</param>
+		public LtsMinAnalysisResult CheckInvariant(Formula invariant, CancellationToken cancellationToken)
+		{
+			Requires.That(!IsDisposed, "The session has already been disposed.");
+			return Check(LtsMin.GetInvariantArgument(invariant), cancellationToken);
+		}
+
+		/// <summary>
+		///   Checks whether the <paramref name="invariants" /> hold in all states of the session's model. The state space is only
+		///   explored once for all invariants, which must have been passed to the session's model creator.
+		/// </summary>
+		/// <param name="invariants">The invariants that should be checked.</param>
+		public LtsMinAnalysisResult[] CheckInvariants(params Formula[] invariants)
+		{
+			return CheckInvariants(invariants, CancellationToken.None);
+		}
+
+		/// <summary>
+		///   Checks whether the <paramref name="invariants" /> hold in all states of the session's model. The state space is only
+		///   explored once for all invariants, which must have been passed to the session's model creator. The checks are
+		///   inconclusive if they are canceled via the <paramref name="cancellationToken" /> before LtsMin completes them.
+		/// </summary>
+		/// <param name="invariants">The invariants that should be checked.</param>
+		/// <param name="cancellationToken">The token that can be used to cancel the checks.</param>
+		public LtsMinAnalysisResult[] CheckInvariants(Formula[] invariants, CancellationToken cancellationToken)
+		{
+			Requires.NotNull(invariants, nameof(invariants));
+			Requires.That(!IsDisposed, "The session has already been disposed.");
+
+			var indices = invariants.Select(invariant => Array.IndexOf(_formulas, invariant)).ToArray();
+			Requires.That(indices.All(index => index != -1), nameof(invariants), "The invariants must have been passed to the model creator.");
+
+			if (!invariants.All(invariant => invariant.IsStateFormula()))
+				throw new InvalidOperationException("Invariants must be non-temporal state formulas.");
+
+			// LtsMin does not check any property itself; instead, the plugin evaluates the requested invariants for every state it
+			// explores and reports the violated ones
+			using (var resultFile = new TemporaryFile("txt"))
+			{
+				var checkArgument = $"--ssharp-invariants=\"{resultFile.FilePath}\" --ssharp-invariant-indices={String.Join(",", indices.Distinct())}";
+				var result = _ltsMin.Check(_modelFile.FilePath, _artifactsDirectory, checkArgument, cancellationToken);
+
+				// A reported violation is certain even if the run was stopped afterwards; whether the other invariants hold is only
+				// known if the run has completed
+				var violations = File.Exists(resultFile.FilePath) ? File.ReadAllLines(resultFile.FilePath).Select(Int32.Parse).ToArray() : new int[0];
+				var otherwise = result.Termination == LtsMinTermination.Completed ? InvariantVerdict.Holds : InvariantVerdict.Unknown;
+
+				return indices
+					.Select(index => new LtsMinAnalysisResult(violations.Contains(index) ? InvariantVerdict.Violated : otherwise, result.Statistics))
+					.ToArray();
+			}
+		}
+
+		/// <summary>
+		///   Performs the check requested by <paramref name="checkArgument" />, generating a counter example if the checked formula
+		///   is violated and the model checker is configured to do so.
+		/// </summary>
+		/// <param name="checkArgument">The argument passed to LtsMin that indicates which kind of check to perform.</param>
+		/// <param name="cancellationToken">The token that can be used to cancel the check.</param>
+		private LtsMinAnalysisResult Check(string checkArgument, CancellationToken cancellationToken)
+		{
+			if (!_ltsMin.GeneratesCounterExamples)
+				return _ltsMin.Check(_modelFile.FilePath, _artifactsDirectory, checkArgument, cancellationToken);
+
+			using (var traceFile = new TemporaryFile("gcf"))
+			using (var csvFile = new TemporaryFile("csv"))
+			{
+				var result = _ltsMin.Check(_modelFile.FilePath, _artifactsDirectory, checkArgument, cancellationToken, traceFile.FilePath);
+				if (result.Verdict != InvariantVerdict.Violated || !File.Exists(traceFile.FilePath))
+					return result;
+
+				_ltsMin.ConvertTrace(traceFile.FilePath, csvFile.FilePath);
+				result.CounterExample = CreateCounterExample(csvFile.FilePath);
+
+				return result;
+			}
+		}
+
+		/// <summary>
+		///   Creates a counter example from the trace stored in <paramref name="traceFile" />. The trace only contains the model's
+		///   states, so the nondeterministic choices and fault activations leading from one state to the next are recovered by
+		///   replaying the model.
+		/// </summary>
+		/// <param name="traceFile">The file the converted trace is stored in.</param>
+		private CounterExample CreateCounterExample(string traceFile)
+		{
+			using (var model = _createModel.Create(0))
+			{
+				var path = LtsMinTrace.Load(traceFile, model);
+				return model.CreateCounterExample(_createModel, path, endsWithException: false);
+			}
+		}
+
+		/// <summary>
+		///   Disposes the object, releasing all managed and unmanaged resources.
+		/// </summary>
+		/// <param name="disposing">If true, indicates that the object is disposed; otherwise, the object is finalized.</param>
+		protected override void OnDisposing(bool disposing)
+		{
+			if (!disposing)
+				return;
+
+			_modelFile.SafeDispose();
+
+			if (Directory.Exists(_artifactsDirectory))
+				Directory.Delete(_artifactsDirectory, recursive: true);
+		}
+	}
+}
@@ -0,0 +1,50 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace SafetySharp.Analysis
+{
+	/// <summary>
+	///   Determines how the enumerative LtsMin tools store the states they have visited.
+	/// </summary>
+	public enum LtsMinStateStorage
+	{
+		/// <summary>
+		///   Indicates that the tool's default state storage is used.
+		/// </summary>
+		Default,
+
+		/// <summary>
+		///   Indicates that the states are stored uncompressed in a hash table.
+		/// </summary>
+		Table,
+
+		/// <summary>
+		///   Indicates that the states are stored in a tree that shares common parts of the state vectors.
+		/// </summary>
+		Tree,
+
+		/// <summary>
+		///   Indicates that the states are stored in a tree with a compact Cleary hash table as its root; only supported by the
+		///   multi-core tool.
+		/// </summary>
+		ClearyTree
+	}
+}
@@ -0,0 +1,234 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace SafetySharp.Analysis
+{
+	using System;
+	using System.Globalization;
+	using System.Text.RegularExpressions;
+
+	/// <summary>
+	///   Provides statistics about an LtsMin run that are extracted from the output of the LtsMin tools. Values that were not
+	///   reported by the tool are <c>null</c>.
+	/// </summary>
+	public class LtsMinStatistics
+	{
+		/// <summary>
+		///   The header of the comma-separated values returned by <see cref="ToCsv" />.
+		/// </summary>
+		public const string CsvHeader = "Check,States,Transitions,Levels,PeakMemoryBytes,ExplorationSeconds,CpuSeconds,FillRatio,ElapsedSeconds,Termination";
+
+		/// <summary>
+		///   Matches the prefix of all lines printed by the LtsMin tools, e.g. <c>pins2lts-seq, 0.130: </c> or
+		///   <c>pins2lts-mc( 0/ 4), 0.130: </c>. Lines printed by the plugin itself are never matched.
+		/// </summary>
+		private const string ToolPrefix = @"^[\w.-]+(?:\(\s*\d+/\s*\d+\))?, [\d.]+: ";
+
+		/// <summary>
+		///   Matches the summary line of pins2lts-seq, e.g. <c>state space 12 levels, 101 states 1234 transitions</c>.
+		/// </summary>
+		private static readonly Regex SequentialSummary =
+			new Regex(ToolPrefix + @"state space (?<levels>\d+) levels, (?<states>\d+) states (?<transitions>\d+) transitions$",
+				RegexOptions.Compiled);
+
+		/// <summary>
+		///   Matches the summary line of pins2lts-mc, e.g. <c>Explored 101 states 1234 transitions, fanout: 12.218</c>.
+		/// </summary>
+		private static readonly Regex MultiCoreSummary =
+			new Regex(ToolPrefix + @"Explored (?<states>\d+) states (?<transitions>\d+) transitions, fanout:", RegexOptions.Compiled);
+
+		/// <summary>
+		///   Matches the number of states reported by pins2lts-mc and pins2lts-sym, e.g. <c>State space has 101 states, 0 are
+		///   accepting</c> or <c>state space has 1.2e+06 (~1234567) states, 4321 BDD nodes</c>.
+		/// </summary>
+		private static readonly Regex States =
+			new Regex(ToolPrefix + @"state space has (?:[\d.e+]+ \(~)?(?<states>\d+)\)? states,", RegexOptions.Compiled | RegexOptions.IgnoreCase);
+
+		/// <summary>
+		///   Matches the exploration time reported by pins2lts-seq, e.g. <c>Exploration time 0.010 sec (0.008 sec user, 0.001 sec
+		///   sys)</c>, and by pins2lts-mc, e.g. <c>Total exploration time 0.010 sec (0.010 sec minimum, 0.010 sec on average)</c>.
+		/// </summary>
+		private static readonly Regex ExplorationTimes =
+			new Regex(ToolPrefix + @"(?:Total e|E)xploration time (?<wall>[\d.]+) sec(?: \((?<user>[\d.]+) sec user, (?<sys>[\d.]+) sec sys\))?",
+				RegexOptions.Compiled);
+
+		/// <summary>
+		///   Matches the total memory estimate of pins2lts-mc, e.g. <c>Est. total memory use: 257.0MB (~1024.0MB paged-in)</c>.
+		/// </summary>
+		private static readonly Regex Memory =
+			new Regex(ToolPrefix + @"Est\. total memory use: (?<value>[\d.]+)\s*(?<unit>[KMGT]?B)", RegexOptions.Compiled);
+
+		/// <summary>
+		///   Matches the fill ratio of the state storage of pins2lts-mc, e.g. <c>Tree fill ratio (roots/leafs): 12.5%/0.4%</c> or
+		///   <c>Table memory: 256.0MB, fill ratio: 0.1%</c>; for trees, the ratio of the root table is used.
+		/// </summary>
+		private static readonly Regex FillRatios =
+			new Regex(ToolPrefix + @"(?:Tree fill ratio \(roots/leafs\)|Table memory: [\d.]+\s*[KMGT]?B, fill ratio): (?<ratio>[\d.]+)%",
+				RegexOptions.Compiled);
+
+		/// <summary>
+		///   Gets the number of states of the explored state space.
+		/// </summary>
+		public long? StateCount { get; private set; }
+
+		/// <summary>
+		///   Gets the number of transitions of the explored state space.
+		/// </summary>
+		public long? TransitionCount { get; private set; }
+
+		/// <summary>
+		///   Gets the number of breadth-first levels of the explored state space. Only pins2lts-seq reports this value.
+		/// </summary>
+		public int? LevelCount { get; private set; }
+
+		/// <summary>
+		///   Gets the total amount of memory in bytes the tool estimated to use. Only pins2lts-mc reports this value.
+		/// </summary>
+		public long? PeakMemoryInBytes { get; private set; }
+
+		/// <summary>
+		///   Gets the wall-clock time the tool reported for the exploration of the state space.
+		/// </summary>
+		public TimeSpan? ExplorationTime { get; private set; }
+
+		/// <summary>
+		///   Gets the CPU time the tool reported for the exploration of the state space.
+		/// </summary>
+		public TimeSpan? CpuTime { get; private set; }
+
+		/// <summary>
+		///   Gets the fill ratio in percent of the tool's state storage.
+		/// </summary>
+		public double? FillRatio { get; private set; }
+
+		/// <summary>
+		///   Gets the wall-clock time of the entire LtsMin run, including the time required to load the model.
+		/// </summary>
+		public TimeSpan ElapsedTime { get; internal set; }
+
+		/// <summary>
+		///   Gets a value describing how the LtsMin run ended. All other statistics are partial if the run did not complete.
+		/// </summary>
+		public LtsMinTermination Termination { get; internal set; }
+
+		/// <summary>
+		///   Extracts the statistics from the given <paramref name="line" /> of LtsMin's output, if any.
+		/// </summary>
+		/// <param name="line">The line of output that should be parsed.</param>
+		internal void Parse(string line)
+		{
+			var match = SequentialSummary.Match(line);
+			if (match.Success)
+			{
+				LevelCount = (int)ParseLong(match, "levels");
+				StateCount = ParseLong(match, "states");
+				TransitionCount = ParseLong(match, "transitions");
+			}
+
+			match = MultiCoreSummary.Match(line);
+			if (match.Success)
+			{
+				StateCount = ParseLong(match, "states");
+				TransitionCount = ParseLong(match, "transitions");
+			}
+
+			match = States.Match(line);
+			if (match.Success)
+				StateCount = ParseLong(match, "states");
+
+			match = ExplorationTimes.Match(line);
+			if (match.Success)
+			{
+				ExplorationTime = TimeSpan.FromSeconds(ParseDouble(match, "wall"));
+				if (match.Groups["user"].Success)
+					CpuTime = TimeSpan.FromSeconds(ParseDouble(match, "user") + ParseDouble(match, "sys"));
+			}
+
+			match = Memory.Match(line);
+			if (match.Success)
+				PeakMemoryInBytes = (long)(ParseDouble(match, "value") * GetUnitSize(match.Groups["unit"].Value));
+
+			match = FillRatios.Match(line);
+			if (match.Success)
+				FillRatio = ParseDouble(match, "ratio");
+		}
+
+		/// <summary>
+		///   Gets the statistics as a line of comma-separated values in the order given by <see cref="CsvHeader" />.
+		/// </summary>
+		/// <param name="check">A description of the check the statistics belong to.</param>
+		public string ToCsv(string check)
+		{
+			Func<object, string> format = value => value == null ? String.Empty : Convert.ToString(value, CultureInfo.InvariantCulture);
+			var values = new[]
+			{
+				"\"" + (check ?? String.Empty).Replace("\"", "\"\"") + "\"",
+				format(StateCount),
+				format(TransitionCount),
+				format(LevelCount),
+				format(PeakMemoryInBytes),
+				format(ExplorationTime?.TotalSeconds),
+				format(CpuTime?.TotalSeconds),
+				format(FillRatio),
+				format(ElapsedTime.TotalSeconds),
+				format(Termination)
+			};
+
+			return String.Join(",", values);
+		}
+
+		/// <summary>
+		///   Parses the <paramref name="group" /> of the <paramref name="match" /> as an integer.
+		/// </summary>
+		private static long ParseLong(Match match, string group)
+		{
+			return Int64.Parse(match.Groups[group].Value, CultureInfo.InvariantCulture);
+		}
+
+		/// <summary>
+		///   Parses the <paramref name="group" /> of the <paramref name="match" /> as a floating point number.
+		/// </summary>
+		private static double ParseDouble(Match match, string group)
+		{
+			return Double.Parse(match.Groups[group].Value, CultureInfo.InvariantCulture);
+		}
+
+		/// <summary>
+		///   Gets the number of bytes represented by the memory <paramref name="unit" />.
+		/// </summary>
+		private static long GetUnitSize(string unit)
+		{
+			switch (unit.ToUpperInvariant())
+			{
+				case "KB":
+					return 1L << 10;
+				case "MB":
+					return 1L << 20;
+				case "GB":
+					return 1L << 30;
+				case "TB":
+					return 1L << 40;
+				default:
+					return 1;
+			}
+		}
+	}
+}
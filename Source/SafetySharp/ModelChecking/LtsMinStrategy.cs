@@ -0,0 +1,50 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace SafetySharp.Analysis
+{
+	/// <summary>
+	///   Determines the order in which the enumerative LtsMin tools explore the state space of a model.
+	/// </summary>
+	public enum LtsMinStrategy
+	{
+		/// <summary>
+		///   Indicates that the tool's default strategy is used.
+		/// </summary>
+		Default,
+
+		/// <summary>
+		///   Indicates that the state space is explored in breadth-first order.
+		/// </summary>
+		BreadthFirst,
+
+		/// <summary>
+		///   Indicates that the state space is explored in strict breadth-first order, i.e., all workers finish a level before
+		///   any of them continues with the next one.
+		/// </summary>
+		StrictBreadthFirst,
+
+		/// <summary>
+		///   Indicates that the state space is explored in depth-first order.
+		/// </summary>
+		DepthFirst
+	}
+}
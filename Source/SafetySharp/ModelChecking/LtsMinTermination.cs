@@ -0,0 +1,50 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+namespace SafetySharp.Analysis
+{
+	/// <summary>
+	///   Describes how an LtsMin run ended.
+	/// </summary>
+	public enum LtsMinTermination
+	{
+		/// <summary>
+		///   Indicates that LtsMin explored the state space as required by the check and determined whether the formula holds.
+		/// </summary>
+		Completed,
+
+		/// <summary>
+		///   Indicates that the run was canceled before LtsMin completed the check.
+		/// </summary>
+		Canceled,
+
+		/// <summary>
+		///   Indicates that LtsMin did not complete the check within the configured time limit.
+		/// </summary>
+		TimedOut,
+
+		/// <summary>
+		///   Indicates that LtsMin exceeded the configured memory limit before completing the check.
+		/// </summary>
+		MemoryLimitExceeded
+	}
+}
@@ -0,0 +1,157 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+namespace SafetySharp.Analysis
+{
+	using System;
+	using System.Collections.Generic;
+	using System.IO;
+	using System.Linq;
+	using ISSE.SafetyChecking.Utilities;
+	using Runtime;
+	using Runtime.Serialization;
+
+	/// <summary>
+	///   Converts the traces written by LtsMin back to the state vectors of a S# model. The traces are expected in the
+	///   comma-separated format written by <c>ltsmin-printtrace</c> with value indices instead of value names.
+	/// </summary>
+	internal static class LtsMinTrace
+	{
+		/// <summary>
+		///   The character separating the columns of a trace.
+		/// </summary>
+		private const char Separator = ',';
+
+		/// <summary>
+		///   Loads the states of the trace stored in <paramref name="traceFile" />. The pseudo initial state exported for models
+		///   with multiple initial states is removed from the returned path, so the path starts with one of the model's initial
+		///   states.
+		/// </summary>
+		/// <param name="traceFile">The file the trace is stored in.</param>
+		/// <param name="model">The model the trace has been generated for; it must not reserve a state header.</param>
+		public static byte[][] Load(string traceFile, SafetySharpRuntimeModel model)
+		{
+			Requires.NotNullOrWhitespace(traceFile, nameof(traceFile));
+			Requires.NotNull(model, nameof(model));
+
+			var lines = File.ReadAllLines(traceFile).Where(line => !String.IsNullOrWhiteSpace(line)).ToArray();
+			if (lines.Length == 0)
+				throw new InvalidOperationException("The counter example generated by LtsMin is empty.");
+
+			var columns = GetColumnIndices(lines[0]);
+			int headerColumn;
+			if (!columns.TryGetValue(LtsMin.InitialChoiceSlotName, out headerColumn))
+				headerColumn = -1;
+
+			// The state slots are matched by name; columns that do not belong to the model's state vector, such as the state labels
+			// or the slots added by LtsMin's LTL layer, are ignored
+			var variables = GetVariables(model, columns, headerColumn == -1 ? 0 : 1);
+			var path = new List<byte[]>(lines.Length - 1);
+
+			// The pseudo initial state stores the values of the first initial state, so it is kept only if the trace ends there
+			for (var i = 1; i < lines.Length; ++i)
+			{
+				var values = lines[i].Split(Separator);
+				if (headerColumn != -1 && Int32.Parse(values[headerColumn]) != 0 && i != lines.Length - 1)
+					continue;
+
+				var state = new byte[model.StateVectorSize];
+				foreach (var variable in variables)
+					WriteBits(state, variable.Item2.OffsetInBits, variable.Item2.SizeInBits, Int32.Parse(values[variable.Item1]));
+
+				path.Add(state);
+			}
+
+			return path.ToArray();
+		}
+
+		/// <summary>
+		///   Gets the indices of the columns declared by the <paramref name="header" /> line, indexed by the names of the state
+		///   slots and labels they store.
+		/// </summary>
+		/// <param name="header">The header line of the trace.</param>
+		private static Dictionary<string, int> GetColumnIndices(string header)
+		{
+			var columns = new Dictionary<string, int>();
+			var names = header.Split(Separator);
+
+			// Columns might be annotated with the type of the values they store, separated by a colon
+			for (var i = 0; i < names.Length; ++i)
+			{
+				var typeSeparator = names[i].IndexOf(':');
+				var name = (typeSeparator == -1 ? names[i] : names[i].Substring(0, typeSeparator)).Trim();
+
+				if (name.Length != 0 && !columns.ContainsKey(name))
+					columns.Add(name, i);
+			}
+
+			return columns;
+		}
+
+		/// <summary>
+		///   Gets the variables of the <paramref name="model" />'s state vector stored in the trace's columns. Depending on the
+		///   layout LtsMin has been run with, either the 32 bit words of the bit-packed state vector or the individual state
+		///   variables are exported.
+		/// </summary>
+		/// <param name="model">The model the trace has been generated for.</param>
+		/// <param name="columns">The indices of the trace's columns.</param>
+		/// <param name="headerSlotCount">The number of state slots preceding the model's state vector.</param>
+		private static Tuple<int, StateVariable>[] GetVariables(SafetySharpRuntimeModel model, Dictionary<string, int> columns, int headerSlotCount)
+		{
+			int column;
+			if (columns.TryGetValue($"state{headerSlotCount}", out column))
+			{
+				var wordCount = (model.StateVectorSize + 3) / 4;
+				return Enumerable.Range(0, wordCount).Select(word =>
+				{
+					if (!columns.TryGetValue($"state{word + headerSlotCount}", out column))
+						throw new InvalidOperationException("The counter example generated by LtsMin does not match the model's state vector.");
+
+					var size = Math.Min(32, model.StateVectorSize * 8 - word * 32);
+					return Tuple.Create(column, new StateVariable { OffsetInBits = word * 32, SizeInBits = size });
+				}).ToArray();
+			}
+
+			return model.StateVectorLayout.GetStateVariables(0).Select(variable =>
+			{
+				if (!columns.TryGetValue(variable.Name, out column))
+					throw new InvalidOperationException("The counter example generated by LtsMin does not match the model's state vector.");
+
+				return Tuple.Create(column, variable);
+			}).ToArray();
+		}
+
+		/// <summary>
+		///   Writes the lower <paramref name="sizeInBits" /> bits of <paramref name="value" /> to the <paramref name="state" />,
+		///   starting at the bit with the <paramref name="offsetInBits" />. The bit-packed state vectors store all values little
+		///   endian.
+		/// </summary>
+		private static void WriteBits(byte[] state, int offsetInBits, int sizeInBits, int value)
+		{
+			var mask = sizeInBits == 32 ? UInt32.MaxValue : (1u << sizeInBits) - 1;
+			var bits = (ulong)((uint)value & mask) << (offsetInBits % 8);
+
+			for (var i = offsetInBits / 8; bits != 0; ++i, bits >>= 8)
+				state[i] |= (byte)bits;
+		}
+	}
+}
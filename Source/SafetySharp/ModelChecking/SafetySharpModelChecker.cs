@@ -47,6 +47,12 @@ namespace SafetySharp.Analysis
 		/// </summary>
 		public ExecutableCounterExample<SafetySharpRuntimeModel> ExecutableCounterExample { get; internal set; }
 
+		/// <summary>
+		///   Gets the model checker that produced the result if the check was performed by a
+		///   <see cref="SafetySharpPortfolioChecker" />, or <c>null</c> otherwise.
+		/// </summary>
+		public PortfolioEngine? Engine { get; internal set; }
+
 		public static SafetySharpInvariantAnalysisResult FromInvariantAnalysisResult(InvariantAnalysisResult result, CoupledExecutableModelCreator<SafetySharpRuntimeModel> modelCreator)
 		{
 			var executableModel = modelCreator?.Create(0);
@@ -57,7 +63,7 @@ namespace SafetySharp.Analysis
 			{
 				CounterExample = result.CounterExample,
 				ExecutableCounterExample = executableCounterExample,
-				FormulaHolds = result.FormulaHolds,
+				Verdict = result.Verdict,
 				StateCount = result.StateCount,
 				TransitionCount = result.TransitionCount,
 				ComputedTransitionCount = result.TransitionCount,
@@ -74,6 +80,12 @@ namespace SafetySharp.Analysis
 	{
 		public static AnalysisConfiguration TraversalConfiguration;
 
+		/// <summary>
+		///   The file the winners of the checks performed by <see cref="CheckInvariantWithPortfolio" /> are recorded in, or
+		///   <c>null</c> if the winners should not be recorded.
+		/// </summary>
+		public static string PortfolioHistoryFile;
+
 		static SafetySharpModelChecker()
 		{
 			TraversalConfiguration = AnalysisConfiguration.Default;
@@ -90,7 +102,13 @@ namespace SafetySharp.Analysis
 		public static SafetySharpInvariantAnalysisResult Check(ModelBase model, Formula formula)
 		{
 			var createModel = SafetySharpRuntimeModel.CreateExecutedModelCreator(model, formula);
-			var result = new LtsMin().Check(createModel, formula);
+			var ltsMin = new LtsMin
+			{
+				LimitOfActiveFaults = TraversalConfiguration.LimitOfActiveFaults,
+				AllowFaultsOnInitialTransitions = TraversalConfiguration.AllowFaultsOnInitialTransitions
+			};
+
+			var result = ltsMin.Check(createModel, formula);
 
 			return SafetySharpInvariantAnalysisResult.FromInvariantAnalysisResult(result, createModel);
 		}
@@ -109,6 +127,18 @@ namespace SafetySharp.Analysis
 			return SafetySharpInvariantAnalysisResult.FromInvariantAnalysisResult(result, createModel);
 		}
 
+		/// <summary>
+		///   Checks whether the <paramref name="invariant" /> holds in all states of the <paramref name="model" />, racing LtsMin
+		///   against the built-in model checker and returning the result of the one that completes the check first.
+		/// </summary>
+		/// <param name="model">The model that should be checked.</param>
+		/// <param name="invariant">The invariant that should be checked.</param>
+		public static SafetySharpInvariantAnalysisResult CheckInvariantWithPortfolio(ModelBase model, Formula invariant)
+		{
+			var portfolioChecker = new SafetySharpPortfolioChecker(TraversalConfiguration) { HistoryFile = PortfolioHistoryFile };
+			return portfolioChecker.CheckInvariant(model, invariant);
+		}
+
 		/// <summary>
 		///   Checks whether the <paramref name="invariants" /> hold in all states of the <paramref name="model" />. The appropriate
 		///   model checker is chosen automatically.
@@ -0,0 +1,201 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+namespace SafetySharp.Analysis
+{
+	using System;
+	using System.Diagnostics;
+	using System.Globalization;
+	using System.IO;
+	using System.Linq;
+	using System.Runtime.ExceptionServices;
+	using System.Threading;
+	using System.Threading.Tasks;
+	using ISSE.SafetyChecking;
+	using ISSE.SafetyChecking.AnalysisModel;
+	using ISSE.SafetyChecking.FaultMinimalKripkeStructure;
+	using ISSE.SafetyChecking.Formula;
+	using ISSE.SafetyChecking.Utilities;
+	using Modeling;
+	using Runtime;
+
+	/// <summary>
+	///   Checks invariants by racing <see cref="Analysis.LtsMin" /> against the built-in qualitative model checker. Which of the
+	///   two is faster depends on the model and is hard to predict; the result of the model checker that completes the check
+	///   first is returned, the other one is canceled.
+	/// </summary>
+	public class SafetySharpPortfolioChecker
+	{
+		/// <summary>
+		///   The header line of the <see cref="HistoryFile" />.
+		/// </summary>
+		public const string HistoryHeader = "Model,Invariant,Engine,ElapsedSeconds";
+
+		/// <summary>
+		///   The configuration of the built-in qualitative model checker.
+		/// </summary>
+		public AnalysisConfiguration Configuration;
+
+		/// <summary>
+		///   The LtsMin instance that is raced against the built-in qualitative model checker. Its fault activation settings are
+		///   overwritten with the ones of the <see cref="Configuration" /> before each check.
+		/// </summary>
+		public LtsMin LtsMin = new LtsMin();
+
+		/// <summary>
+		///   The file the winner of each race is appended to as comma-separated values, or <c>null</c> if the winners should not be
+		///   recorded. A header line is written when the file is created.
+		/// </summary>
+		public string HistoryFile;
+
+		/// <summary>
+		///   Initializes a new instance.
+		/// </summary>
+		/// <param name="configuration">The configuration of the built-in qualitative model checker.</param>
+		public SafetySharpPortfolioChecker(AnalysisConfiguration configuration)
+		{
+			Configuration = configuration;
+			Configuration.UseCompactStateStorage = true;
+		}
+
+		/// <summary>
+		///   Checks whether the <paramref name="invariant" /> holds in all states of the <paramref name="model" />.
+		/// </summary>
+		/// <param name="model">The model that should be checked.</param>
+		/// <param name="invariant">The invariant that should be checked.</param>
+		public SafetySharpInvariantAnalysisResult CheckInvariant(ModelBase model, Formula invariant)
+		{
+			Requires.NotNull(model, nameof(model));
+			Requires.NotNull(invariant, nameof(invariant));
+
+			// Each model checker gets a model creator of its own, as they must not share any model instances; the model is
+			// serialized for both model checkers before the race starts
+			var ltsMinModel = SafetySharpRuntimeModel.CreateExecutedModelCreator(model, invariant);
+			var qualitativeModel = SafetySharpRuntimeModel.CreateExecutedModelCreator(model, invariant);
+			var qualitativeChecker = new QualitativeChecker<SafetySharpRuntimeModel>(qualitativeModel) { Configuration = Configuration };
+
+			// Both model checkers must explore the same state space, otherwise the winner would determine the result
+			LtsMin.LimitOfActiveFaults = Configuration.LimitOfActiveFaults;
+			LtsMin.AllowFaultsOnInitialTransitions = Configuration.AllowFaultsOnInitialTransitions;
+
+			using (var session = LtsMin.OpenSession(ltsMinModel))
+			using (var cancellation = new CancellationTokenSource())
+			{
+				var stopwatch = Stopwatch.StartNew();
+				var tasks = new[]
+				{
+					Task.Run(() => (InvariantAnalysisResult)session.CheckInvariant(invariant, cancellation.Token)),
+					Task.Run(() => qualitativeChecker.CheckInvariant(invariant, cancellation.Token))
+				};
+
+				var winner = AwaitFirstConclusiveResult(tasks);
+
+				// The loser is stopped and awaited, as the session's model file must not be deleted while LtsMin still uses it
+				cancellation.Cancel();
+				AwaitTermination(tasks);
+				stopwatch.Stop();
+
+				if (winner == -1)
+					ExceptionDispatchInfo.Capture(GetFailure(tasks)).Throw();
+
+				var engine = winner == 0 ? PortfolioEngine.LtsMin : PortfolioEngine.QualitativeChecker;
+				var createModel = winner == 0 ? ltsMinModel : qualitativeModel;
+				var result = SafetySharpInvariantAnalysisResult.FromInvariantAnalysisResult(tasks[winner].Result, createModel);
+
+				result.Engine = engine;
+				RecordWinner(model, invariant, engine, stopwatch.Elapsed);
+
+				return result;
+			}
+		}
+
+		/// <summary>
+		///   Waits until one of the <paramref name="tasks" /> has produced a conclusive result, returning its index, or until all
+		///   of them have completed without producing one, returning -1.
+		/// </summary>
+		private static int AwaitFirstConclusiveResult(Task<InvariantAnalysisResult>[] tasks)
+		{
+			var pending = tasks.ToList();
+			while (pending.Count > 0)
+			{
+				var task = pending[Task.WaitAny(pending.ToArray())];
+				if (IsConclusive(task))
+					return Array.IndexOf(tasks, task);
+
+				pending.Remove(task);
+			}
+
+			return -1;
+		}
+
+		/// <summary>
+		///   Checks whether the completed <paramref name="task" /> has produced a conclusive result.
+		/// </summary>
+		private static bool IsConclusive(Task<InvariantAnalysisResult> task)
+		{
+			return task.Status == TaskStatus.RanToCompletion && task.Result.Verdict != InvariantVerdict.Unknown;
+		}
+
+		/// <summary>
+		///   Waits until all <paramref name="tasks" /> have completed, ignoring any exceptions they have thrown.
+		/// </summary>
+		private static void AwaitTermination(Task[] tasks)
+		{
+			try
+			{
+				Task.WaitAll(tasks);
+			}
+			catch (AggregateException)
+			{
+				// The exceptions are reported by GetFailure if no model checker has produced a conclusive result
+			}
+		}
+
+		/// <summary>
+		///   Gets the exception explaining why none of the <paramref name="tasks" /> has produced a conclusive result.
+		/// </summary>
+		private static Exception GetFailure(Task<InvariantAnalysisResult>[] tasks)
+		{
+			var exception = tasks.Where(task => task.IsFaulted).Select(task => task.Exception.InnerException).FirstOrDefault();
+			return exception ?? new InvalidOperationException("Neither LtsMin nor the qualitative model checker completed the check.");
+		}
+
+		/// <summary>
+		///   Appends the <paramref name="engine" /> that won the race for the <paramref name="invariant" /> of the
+		///   <paramref name="model" /> to the <see cref="HistoryFile" />, if any.
+		/// </summary>
+		private void RecordWinner(ModelBase model, Formula invariant, PortfolioEngine engine, TimeSpan elapsedTime)
+		{
+			if (HistoryFile == null)
+				return;
+
+			if (!File.Exists(HistoryFile))
+				File.WriteAllText(HistoryFile, HistoryHeader + Environment.NewLine);
+
+			Func<object, string> quote = value => "\"" + value.ToString().Replace("\"", "\"\"") + "\"";
+			var line = String.Join(",", quote(model.GetType().FullName), quote(invariant), engine,
+				elapsedTime.TotalSeconds.ToString(CultureInfo.InvariantCulture));
+
+			File.AppendAllText(HistoryFile, line + Environment.NewLine);
+		}
+	}
+}
@@ -64,7 +64,6 @@ namespace SafetySharp.Runtime
 			var objectTable = serializedData.ObjectTable;
 			var formulas = serializedData.Formulas;
 
-			Requires.NotNull(buffer, nameof(buffer));
 			Requires.NotNull(rootComponents, nameof(rootComponents));
 			Requires.NotNull(objectTable, nameof(objectTable));
 			Requires.NotNull(formulas, nameof(formulas));
@@ -107,6 +106,11 @@ namespace SafetySharp.Runtime
 		/// </summary>
 		internal ObjectTable Objects { get; }
 
+		/// <summary>
+		///   Gets the objects whose state is stored in the model's state vectors.
+		/// </summary>
+		internal ObjectTable SerializedObjects => _serializedObjects;
+
 		/// <summary>
 		///   Gets the model's <see cref="StateVectorLayout" />.
 		/// </summary>
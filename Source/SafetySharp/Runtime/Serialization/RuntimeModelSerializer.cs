@@ -22,7 +22,9 @@
 
 namespace SafetySharp.Runtime.Serialization
 {
+	using System;
 	using System.IO;
+	using System.IO.MemoryMappedFiles;
 	using System.Linq;
 	using System.Text;
 	using Analysis;
@@ -39,6 +41,7 @@ namespace SafetySharp.Runtime.Serialization
 		private readonly object _syncObject = new object();
 		private OpenSerializationDelegate _deserializer;
 		private byte[] _serializedModel;
+		private Func<Stream> _openSerializedModel;
 		internal StateVectorLayout StateVector { get; private set; }
 
 		#region Serialization
@@ -59,7 +62,10 @@ namespace SafetySharp.Runtime.Serialization
 				SerializeModel(writer, model, formulas);
 
 				lock (_syncObject)
+				{
 					_serializedModel = buffer.ToArray();
+					_openSerializedModel = null;
+				}
 			}
 		}
 
@@ -159,13 +165,32 @@ namespace SafetySharp.Runtime.Serialization
 		}
 
 		/// <summary>
-		///   Loads a <see cref="SerializedRuntimeModel" /> instance.
+		///   Loads a <see cref="SerializedRuntimeModel" /> from the memory-mapped <paramref name="serializedModel" /> file. The file
+		///   is read directly from the mapped pages each time a model is loaded, so its contents are never copied into the managed
+		///   heap. The loaded models do not provide their <see cref="ISSE.SafetyChecking.ExecutableModel.ExecutableModel{T}.SerializedModel" />,
+		///   so counter examples for them cannot be saved.
+		/// </summary>
+		/// <param name="serializedModel">The file the serialized model is stored in; it must remain open while models are loaded.</param>
+		public static RuntimeModelSerializer LoadSerializedData(MemoryMappedFile serializedModel)
+		{
+			Requires.NotNull(serializedModel, nameof(serializedModel));
+
+			return new RuntimeModelSerializer
+			{
+				_openSerializedModel = () => serializedModel.CreateViewStream(0, 0, MemoryMappedFileAccess.Read)
+			};
+		}
+
+		/// <summary>
+		///   Loads a <see cref="SerializedRuntimeModel" /> instance. Models loaded by the same serializer share the generated
+		///   deserialization code, which is only generated for the first model; models can be loaded concurrently.
 		/// </summary>
 		public SerializedRuntimeModel Load()
 		{
-			Requires.That(_serializedModel != null, "No model is loaded that could be serialized.");
+			Requires.That(_serializedModel != null || _openSerializedModel != null, "No model is loaded that could be serialized.");
 
-			using (var reader = new BinaryReader(new MemoryStream(_serializedModel), Encoding.UTF8, leaveOpen: true))
+			var stream = _openSerializedModel?.Invoke() ?? new MemoryStream(_serializedModel, writable: false);
+			using (var reader = new BinaryReader(stream, Encoding.UTF8))
 				return DeserializeModel(_serializedModel, reader);
 		}
 
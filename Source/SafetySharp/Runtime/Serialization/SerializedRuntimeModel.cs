@@ -32,7 +32,7 @@ namespace SafetySharp.Runtime.Serialization
 	internal struct SerializedRuntimeModel
 	{
 		/// <summary>
-		///   The buffer the model was deserialized from.
+		///   The buffer the model was deserialized from, or <c>null</c> if the model was deserialized from a memory-mapped file.
 		/// </summary>
 		public readonly byte[] Buffer;
 
@@ -52,7 +52,7 @@ namespace SafetySharp.Runtime.Serialization
 		public readonly Formula[] Formulas;
 
 		/// <param name="model">A copy of the original model the runtime model was generated from.</param>
-		/// <param name="buffer">The buffer the model was deserialized from.</param>
+		/// <param name="buffer">The buffer the model was deserialized from, if any.</param>
 		/// <param name="objectTable">The table of objects referenced by the model.</param>
 		/// <param name="formulas">The formulas that are checked on the model.</param>
 		internal SerializedRuntimeModel(ModelBase model, byte[] buffer, ObjectTable objectTable, Formula[] formulas)
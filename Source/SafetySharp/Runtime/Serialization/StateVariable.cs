@@ -0,0 +1,90 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+namespace SafetySharp.Runtime.Serialization
+{
+	/// <summary>
+	///   Describes an individual value of at most 32 bits stored in a state vector. Each element of a state slot is represented
+	///   by one variable; elements larger than 32 bits are split into multiple variables.
+	/// </summary>
+	internal class StateVariable
+	{
+		/// <summary>
+		///   The unique name of the variable.
+		/// </summary>
+		public string Name;
+
+		/// <summary>
+		///   The zero-based offset in bits into the state vector, including the state header bytes, where the variable is stored.
+		/// </summary>
+		public int OffsetInBits;
+
+		/// <summary>
+		///   The number of bits used to store the variable.
+		/// </summary>
+		public int SizeInBits;
+
+		/// <summary>
+		///   Indicates whether the variable stores a signed value that must be sign-extended when it is widened to 32 bits.
+		/// </summary>
+		public bool IsSigned;
+
+		/// <summary>
+		///   The name of the variable's type. Variables with the same type name have the same enumeration values or range.
+		/// </summary>
+		public string TypeName = "int";
+
+		/// <summary>
+		///   The names of the values of the variable's type, indexed by the values, or <c>null</c> if the type is not an
+		///   enumeration type.
+		/// </summary>
+		public string[] EnumerationValues;
+
+		/// <summary>
+		///   Indicates whether the variable's values are restricted to the range of <see cref="LowerBound" /> and
+		///   <see cref="UpperBound" />.
+		/// </summary>
+		public bool IsRange;
+
+		/// <summary>
+		///   The inclusive lower bound of the variable's values if <see cref="IsRange" /> is <c>true</c>.
+		/// </summary>
+		public int LowerBound;
+
+		/// <summary>
+		///   The inclusive upper bound of the variable's values if <see cref="IsRange" /> is <c>true</c>.
+		/// </summary>
+		public int UpperBound;
+
+		/// <summary>
+		///   The index of the state slot within the <see cref="StateVectorLayout" /> the variable belongs to or <c>-1</c> if the
+		///   variable represents a part of the state header.
+		/// </summary>
+		public int SlotIndex;
+
+		/// <summary>
+		///   The identifier of the object the variable's slot belongs to or <c>-1</c> if the variable represents a part of the state
+		///   header.
+		/// </summary>
+		public int ObjectIdentifier = -1;
+	}
+}
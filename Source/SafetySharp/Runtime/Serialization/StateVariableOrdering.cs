@@ -0,0 +1,131 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace SafetySharp.Runtime.Serialization
+{
+	using System.Collections.Generic;
+	using System.Linq;
+	using ISSE.SafetyChecking.Utilities;
+
+	/// <summary>
+	///   Orders state variables such that variables that are accessed together are stored close to each other, which is crucial
+	///   for the performance of symbolic model checkers and improves the compression of tree-based state storages. The variables of
+	///   an object are always kept adjacent; the objects are ordered by the number of transition groups or state labels they share.
+	/// </summary>
+	internal static class StateVariableOrdering
+	{
+		/// <summary>
+		///   Orders the <paramref name="variables" /> based on the <paramref name="dependencies" />. Variables representing the state
+		///   header remain at the front.
+		/// </summary>
+		/// <param name="variables">The variables that should be ordered.</param>
+		/// <param name="dependencies">
+		///   For each transition group and state label, flags indicating for each of the <paramref name="variables" /> whether it is
+		///   accessed.
+		/// </param>
+		public static StateVariable[] Order(StateVariable[] variables, IEnumerable<bool[]> dependencies)
+		{
+			Requires.NotNull(variables, nameof(variables));
+			Requires.NotNull(dependencies, nameof(dependencies));
+
+			var header = variables.Where(variable => variable.SlotIndex == -1);
+			var clusters = variables
+				.Select((variable, index) => new { Variable = variable, Index = index })
+				.Where(v => v.Variable.SlotIndex != -1)
+				.GroupBy(v => v.Variable.ObjectIdentifier)
+				.Select(group => group.ToArray())
+				.ToArray();
+
+			var clusterIndices = new int[variables.Length];
+			for (var i = 0; i < clusters.Length; ++i)
+			{
+				foreach (var v in clusters[i])
+					clusterIndices[v.Index] = i;
+			}
+
+			// The affinity of two clusters is the number of dependencies accessing both of them; dependencies that access all
+			// clusters, for instance because their accesses could not be determined statically, do not provide any information
+			var affinities = new int[clusters.Length, clusters.Length];
+			foreach (var dependency in dependencies)
+			{
+				var accessed = Enumerable.Range(0, variables.Length)
+										 .Where(i => dependency[i] && variables[i].SlotIndex != -1)
+										 .Select(i => clusterIndices[i])
+										 .Distinct()
+										 .ToArray();
+
+				if (accessed.Length == clusters.Length)
+					continue;
+
+				foreach (var a in accessed)
+				{
+					foreach (var b in accessed)
+						affinities[a, b] += 1;
+				}
+			}
+
+			// Greedily append the cluster with the highest affinity to the most recently placed cluster, preferring clusters with
+			// a higher affinity to all placed clusters and finally those that come first in the original order
+			var order = new List<int>(clusters.Length);
+			var isPlaced = new bool[clusters.Length];
+			var placedAffinities = new int[clusters.Length];
+
+			while (order.Count < clusters.Length)
+			{
+				var last = order.Count > 0 ? order[order.Count - 1] : -1;
+				var best = -1;
+
+				for (var i = 0; i < clusters.Length; ++i)
+				{
+					if (isPlaced[i])
+						continue;
+
+					if (best == -1 || IsBetterSuccessor(affinities, placedAffinities, last, i, best))
+						best = i;
+				}
+
+				order.Add(best);
+				isPlaced[best] = true;
+
+				for (var i = 0; i < clusters.Length; ++i)
+					placedAffinities[i] += affinities[best, i];
+			}
+
+			return header.Concat(order.SelectMany(cluster => clusters[cluster].Select(v => v.Variable))).ToArray();
+		}
+
+		/// <summary>
+		///   Checks whether the <paramref name="candidate" /> cluster is a better successor of the <paramref name="last" /> placed
+		///   cluster than the <paramref name="best" /> cluster found so far.
+		/// </summary>
+		private static bool IsBetterSuccessor(int[,] affinities, int[] placedAffinities, int last, int candidate, int best)
+		{
+			// The first cluster is the one that is accessed most often
+			if (last == -1)
+				return affinities[candidate, candidate] > affinities[best, best];
+
+			if (affinities[last, candidate] != affinities[last, best])
+				return affinities[last, candidate] > affinities[last, best];
+
+			return placedAffinities[candidate] > placedAffinities[best];
+		}
+	}
+}
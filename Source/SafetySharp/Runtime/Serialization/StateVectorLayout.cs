@@ -169,6 +169,165 @@ namespace SafetySharp.Runtime.Serialization
 				SizeInBytes = 4;
 		}
 
+		/// <summary>
+		///   Gets the offsets in bits of the first elements of the state slots relative to the beginning of the state vector,
+		///   excluding any state header bytes. The offsets are indexed by the slots' positions within the layout.
+		/// </summary>
+		internal int[] GetSlotOffsetsInBits()
+		{
+			Requires.That(Groups != null, "The state vector has not been compacted.");
+
+			var indices = new Dictionary<StateSlotMetadata, int>(ReferenceEqualityComparer<StateSlotMetadata>.Default);
+			for (var i = 0; i < _slots.Count; ++i)
+				indices.Add(_slots[i], i);
+
+			// Within a group, slots are stored consecutively without any padding; Boolean values are stored as individual bits
+			var offsets = new int[_slots.Count];
+			foreach (var group in Groups)
+			{
+				var offset = group.OffsetInBytes * 8;
+				foreach (var slot in group.Slots)
+				{
+					offsets[indices[slot]] = offset;
+					offset += slot.TotalSizeInBits;
+				}
+			}
+
+			return offsets;
+		}
+
+		/// <summary>
+		///   Splits the state vector into individual variables of at most 32 bits each. The variables are ordered by their offsets
+		///   within the state vector; the state header is represented by one variable for each of its 32 bit words.
+		/// </summary>
+		/// <param name="stateHeaderBytes">The number of bytes reserved at the beginning of the state vector.</param>
+		internal StateVariable[] GetStateVariables(int stateHeaderBytes)
+		{
+			Requires.That(stateHeaderBytes % 4 == 0, nameof(stateHeaderBytes), "Expected a multiple of 4.");
+
+			var variables = new List<StateVariable>();
+			for (var i = 0; i < stateHeaderBytes / 4; ++i)
+				variables.Add(new StateVariable { Name = $"header{i}", OffsetInBits = i * 32, SizeInBits = 32, SlotIndex = -1 });
+
+			var offsets = GetSlotOffsetsInBits();
+			var slots = Enumerable.Range(0, _slots.Count).OrderBy(slot => offsets[slot]);
+
+			foreach (var index in slots)
+			{
+				var slot = _slots[index];
+				var type = slot.EffectiveType.IsEnum ? slot.EffectiveType.GetEnumUnderlyingType() : slot.EffectiveType;
+				var isSigned = !slot.DataType.IsReferenceType() &&
+							   (type == typeof(sbyte) || type == typeof(short) || type == typeof(int) || type == typeof(long));
+
+				var chain = slot.FieldChain != null ? "." + String.Join(".", slot.FieldChain.Select(field => field.Name)) : String.Empty;
+				var name = slot.Field == null
+					? $"obj{slot.ObjectIdentifier}"
+					: $"obj{slot.ObjectIdentifier}.{slot.Field.DeclaringType.Name}.{slot.Field.Name}{chain}";
+
+				for (var element = 0; element < slot.ElementCount; ++element)
+				{
+					var elementName = slot.Field == null ? $"{name}[{element}]" : name;
+					var elementOffset = stateHeaderBytes * 8 + offsets[index] + element * slot.ElementSizeInBits;
+					var partCount = (slot.ElementSizeInBits + 31) / 32;
+
+					for (var part = 0; part < partCount; ++part)
+					{
+						var variable = new StateVariable
+						{
+							Name = partCount == 1 ? elementName : $"{elementName}#{part}",
+							OffsetInBits = elementOffset + part * 32,
+							SizeInBits = Math.Min(32, slot.ElementSizeInBits - part * 32),
+							IsSigned = isSigned && partCount == 1,
+							SlotIndex = index,
+							ObjectIdentifier = slot.ObjectIdentifier
+						};
+
+						if (partCount == 1)
+							SetVariableType(variable, slot);
+
+						variables.Add(variable);
+					}
+				}
+			}
+
+			return variables.ToArray();
+		}
+
+		/// <summary>
+		///   Sets the type of the <paramref name="variable" /> that stores an element of the <paramref name="slot" />. Booleans and
+		///   enumerations whose values are numbered consecutively from 0 are represented as enumeration types, other integral values
+		///   with a known range as range types. All other values are represented as unrestricted integers.
+		/// </summary>
+		private static void SetVariableType(StateVariable variable, StateSlotMetadata slot)
+		{
+			if (slot.DataType == typeof(bool))
+			{
+				variable.TypeName = "bool";
+				variable.EnumerationValues = new[] { "false", "true" };
+				return;
+			}
+
+			if (slot.DataType.IsEnum && !slot.DataType.HasAttribute<FlagsAttribute>())
+			{
+				var names = GetEnumerationValues(slot.DataType);
+				if (names != null)
+				{
+					variable.TypeName = slot.DataType.FullName;
+					variable.EnumerationValues = names;
+					return;
+				}
+			}
+
+			var type = slot.DataType.IsEnum ? slot.DataType.GetEnumUnderlyingType() : slot.DataType;
+			var typeCode = Type.GetTypeCode(type);
+
+			if (slot.Range == null || typeCode < TypeCode.SByte || typeCode > TypeCode.UInt64)
+				return;
+
+			long lowerBound, upperBound;
+			try
+			{
+				lowerBound = Convert.ToInt64(slot.Range.LowerBound);
+				upperBound = Convert.ToInt64(slot.Range.UpperBound);
+			}
+			catch (OverflowException)
+			{
+				return;
+			}
+
+			if (lowerBound < Int32.MinValue || upperBound > Int32.MaxValue || lowerBound > upperBound)
+				return;
+
+			variable.TypeName = $"int[{lowerBound},{upperBound}]";
+			variable.IsRange = true;
+			variable.LowerBound = (int)lowerBound;
+			variable.UpperBound = (int)upperBound;
+		}
+
+		/// <summary>
+		///   Gets the names of the values of the <paramref name="enumType" />, indexed by the values, or <c>null</c> if the values are
+		///   not numbered consecutively from 0.
+		/// </summary>
+		private static string[] GetEnumerationValues(Type enumType)
+		{
+			var values = new List<long>();
+			try
+			{
+				foreach (var value in Enum.GetValues(enumType))
+					values.Add(Convert.ToInt64(value));
+			}
+			catch (OverflowException)
+			{
+				return null;
+			}
+
+			values = values.Distinct().OrderBy(value => value).ToList();
+			if (values.Count == 0 || values.Where((value, index) => value != index).Any())
+				return null;
+
+			return values.Select(value => Enum.GetName(enumType, Enum.ToObject(enumType, value))).ToArray();
+		}
+
 		/// <summary>
 		///   Dynamically generates a delegate that can be used to restrict state ranges.
 		/// </summary>
@@ -0,0 +1,810 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+namespace SafetySharp.Runtime
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Linq;
+	using System.Reflection;
+	using System.Reflection.Emit;
+	using ISSE.SafetyChecking.AnalysisModel;
+	using ISSE.SafetyChecking.Modeling;
+	using ISSE.SafetyChecking.Utilities;
+	using Modeling;
+	using Serialization;
+	using Utilities;
+
+	/// <summary>
+	///   Statically determines the state slots of a <see cref="SafetySharpRuntimeModel" /> that are read and written by the model's
+	///   code. The analysis inspects the IL of all methods that are potentially reachable from the analyzed entry points.
+	/// </summary>
+	/// <remarks>
+	///   The analysis is object-insensitive, that is, an access of a field marks the field's slots of all objects as accessed.
+	///   Virtual calls are resolved against the types of all objects referenced by the model, delegate invocations against all
+	///   delegates referenced by the model and all methods whose addresses are taken by reachable code. Whenever the analysis
+	///   encounters code it cannot reason about, it gives up and the result is incomplete, i.e., all slots must be assumed to be
+	///   accessed. Calls of framework methods from model code are assumed to access all state slots of framework objects such as
+	///   arrays or lists; the S# and S# analysis infrastructure, however, are assumed to never modify model state through
+	///   framework methods.
+	/// </remarks>
+	internal sealed class StateAccessAnalysis
+	{
+		private const BindingFlags DeclaredMembers =
+			BindingFlags.Instance | BindingFlags.Static | BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.DeclaredOnly;
+
+		private static readonly Assembly[] InfrastructureAssemblies = { typeof(Component).Assembly, typeof(Fault).Assembly };
+
+		private static readonly Type[] PureFrameworkTypes =
+		{
+			typeof(object), typeof(Math), typeof(string), typeof(decimal), typeof(Enum), typeof(Nullable), typeof(Nullable<>),
+			typeof(Convert), typeof(BitConverter), typeof(Type), typeof(Delegate), typeof(MulticastDelegate), typeof(Exception),
+			typeof(System.Diagnostics.Debug), typeof(System.Runtime.CompilerServices.RuntimeHelpers)
+		};
+
+		private readonly List<int> _arraySlots = new List<int>();
+		private readonly HashSet<Type> _candidateTypes = new HashSet<Type>();
+		private readonly Delegate[] _delegates;
+		private readonly Dictionary<FieldInfo, Fault[]> _faultFields = new Dictionary<FieldInfo, Fault[]>();
+		private readonly Dictionary<FieldKey, List<int>> _fieldSlots = new Dictionary<FieldKey, List<int>>();
+		private readonly List<int> _frameworkSlots = new List<int>();
+		private readonly StateVectorLayout _layout;
+		private readonly SafetySharpRuntimeModel _model;
+		private readonly HashSet<Fault> _unprunableFaults = new HashSet<Fault>(ReferenceEqualityComparer<Fault>.Default);
+
+		// The state of the current analysis run
+		private Func<Fault, bool> _canBeActivated;
+		private bool _frameworkCallbacksAdded;
+		private bool _isComplete;
+		private bool[] _reads;
+		private HashSet<MethodBase> _reachableMethods;
+		private HashSet<MethodInfo> _virtualCalls;
+		private Queue<MethodBase> _worklist;
+		private bool[] _writes;
+
+		/// <summary>
+		///   Initializes a new instance.
+		/// </summary>
+		/// <param name="model">The model that should be analyzed.</param>
+		public StateAccessAnalysis(SafetySharpRuntimeModel model)
+		{
+			Requires.NotNull(model, nameof(model));
+
+			_model = model;
+			_layout = model.StateVectorLayout;
+			_delegates = model.Objects.OfType<Delegate>().ToArray();
+
+			foreach (var obj in model.Objects)
+			{
+				if (obj != null)
+					_candidateTypes.Add(obj.GetType());
+			}
+
+			for (var i = 0; i < _layout.SlotCount; ++i)
+			{
+				var slot = _layout[i];
+
+				if (slot.Field == null)
+					_arraySlots.Add(i);
+				else
+				{
+					AddFieldSlot(slot.Field, i);
+					foreach (var field in slot.FieldChain ?? Enumerable.Empty<FieldInfo>())
+						AddFieldSlot(field, i);
+				}
+
+				if (IsFrameworkType(slot.ObjectType))
+					_frameworkSlots.Add(i);
+			}
+
+			// The activation of faults whose effects undo their activation cannot be used to prune the fault effects' code, as
+			// the effects might have been partially executed when the activation is undone
+			foreach (var component in model.Objects.OfType<Component>())
+			{
+				for (var type = component.GetType(); type != null && type != typeof(Component); type = type.BaseType)
+				{
+					if (!type.HasAttribute<FaultEffectAttribute>())
+						continue;
+
+					var faultField = GetFaultField(type);
+					var fault = faultField?.GetValue(component) as Fault;
+
+					if (fault != null && type.GetMethods(DeclaredMembers).Any(CallsUndoActivation))
+						_unprunableFaults.Add(fault);
+				}
+			}
+		}
+
+		/// <summary>
+		///   Determines the state slots accessed by a step of the model in which only the nondeterministic faults contained in
+		///   <paramref name="activatableFaults" /> can be activated. Faults that are not activated nondeterministically are
+		///   assumed to be activated whenever they are not suppressed.
+		/// </summary>
+		/// <param name="activatableFaults">The nondeterministic faults that can be activated during the step.</param>
+		public StateAccessSet AnalyzeStep(FaultSet activatableFaults)
+		{
+			Func<Fault, bool> canBeActivated = fault =>
+			{
+				if (fault.Activation == Activation.Suppressed)
+					return false;
+
+				if (fault.Activation != Activation.Nondeterministic || !fault.IsUsed || _unprunableFaults.Contains(fault))
+					return true;
+
+				return activatableFaults.Contains(fault);
+			};
+
+			var roots = new List<MethodBase>();
+			var reset = typeof(Fault).GetMethod(nameof(Fault.Reset));
+			var onActivated = typeof(Fault).GetMethod(nameof(Fault.OnActivated));
+			var update = typeof(Component).GetMethod(nameof(Component.Update));
+
+			foreach (var component in _model.RootComponents)
+				roots.Add(ResolveVirtualCall(component.GetType(), update) ?? update);
+
+			foreach (var fault in _model.NondeterministicFaults)
+			{
+				roots.Add(reset);
+				if (fault.RequiresActivationNotification && canBeActivated(fault))
+					roots.Add(ResolveVirtualCall(fault.GetType(), onActivated) ?? onActivated);
+			}
+
+			// State constraints determine which transitions are generated
+			roots.AddRange(_model.StateConstraints.SelectMany(constraint => constraint.GetInvocationList()).Select(d => d.Method));
+
+			return Analyze(roots, canBeActivated);
+		}
+
+		/// <summary>
+		///   Determines the state slots accessed by the <paramref name="function" />.
+		/// </summary>
+		/// <param name="function">The function that should be analyzed.</param>
+		public StateAccessSet AnalyzeDelegate(Delegate function)
+		{
+			Requires.NotNull(function, nameof(function));
+			return Analyze(function.GetInvocationList().Select(d => d.Method), fault => fault.Activation != Activation.Suppressed);
+		}
+
+		/// <summary>
+		///   Computes the state slots accessed by the methods reachable from the <paramref name="roots" />.
+		/// </summary>
+		private StateAccessSet Analyze(IEnumerable<MethodBase> roots, Func<Fault, bool> canBeActivated)
+		{
+			_canBeActivated = canBeActivated;
+			_isComplete = true;
+			_frameworkCallbacksAdded = false;
+			_reads = new bool[_layout.SlotCount];
+			_writes = new bool[_layout.SlotCount];
+			_reachableMethods = new HashSet<MethodBase>();
+			_virtualCalls = new HashSet<MethodInfo>();
+			_worklist = new Queue<MethodBase>();
+
+			foreach (var root in roots)
+				AddReachableMethod(root);
+
+			var candidateTypeCount = -1;
+			while (_isComplete && (_worklist.Count > 0 || candidateTypeCount != _candidateTypes.Count))
+			{
+				while (_isComplete && _worklist.Count > 0)
+					AnalyzeMethod(_worklist.Dequeue());
+
+				// Newly instantiated types might be additional targets of virtual calls analyzed previously
+				candidateTypeCount = _candidateTypes.Count;
+				foreach (var method in _virtualCalls.ToArray())
+					AddVirtualCallTargets(method);
+			}
+
+			return _isComplete ? new StateAccessSet(_layout, _reads, _writes) : new StateAccessSet(_layout);
+		}
+
+		/// <summary>
+		///   Analyzes the IL of the <paramref name="method" />.
+		/// </summary>
+		private void AnalyzeMethod(MethodBase method)
+		{
+			Instruction[] instructions;
+			try
+			{
+				instructions = MethodBodyReader.GetInstructions(method);
+			}
+			catch (InvalidOperationException)
+			{
+				instructions = null;
+			}
+
+			if (instructions == null)
+			{
+				GiveUp();
+				return;
+			}
+
+			var typeArguments = method.DeclaringType != null && method.DeclaringType.IsGenericType ? method.DeclaringType.GetGenericArguments() : null;
+			var methodArguments = method.IsGenericMethod ? method.GetGenericArguments() : null;
+
+			foreach (var instruction in GetReachableInstructions(method, instructions, typeArguments, methodArguments))
+			{
+				var opCode = instruction.OpCode;
+				var token = (int)instruction.Operand;
+
+				if (opCode == OpCodes.Ldfld || opCode == OpCodes.Ldsfld)
+					AccessField(ResolveField(method, token, typeArguments, methodArguments), read: true, write: false);
+				else if (opCode == OpCodes.Stfld || opCode == OpCodes.Stsfld)
+					AccessField(ResolveField(method, token, typeArguments, methodArguments), read: false, write: true);
+				else if (opCode == OpCodes.Ldflda || opCode == OpCodes.Ldsflda)
+					AccessField(ResolveField(method, token, typeArguments, methodArguments), read: true, write: true);
+				else if (opCode == OpCodes.Unbox)
+					AccessSlots(_frameworkSlots, read: true, write: true);
+				else if (opCode == OpCodes.Unbox_Any)
+					AccessSlots(_frameworkSlots, read: true, write: false);
+				else if (opCode.Name.StartsWith("ldelema"))
+					AccessSlots(_arraySlots, read: true, write: true);
+				else if (opCode.Name.StartsWith("ldelem"))
+					AccessSlots(_arraySlots, read: true, write: false);
+				else if (opCode.Name.StartsWith("stelem"))
+					AccessSlots(_arraySlots, read: false, write: true);
+				else if (opCode == OpCodes.Call || opCode == OpCodes.Callvirt || opCode == OpCodes.Newobj)
+					AnalyzeCall(method, ResolveMethod(method, token, typeArguments, methodArguments), opCode);
+				else if (opCode == OpCodes.Ldftn)
+					AddReachableMethod(ResolveMethod(method, token, typeArguments, methodArguments));
+				else if (opCode == OpCodes.Ldvirtftn)
+					AddVirtualCallTargets((MethodInfo)ResolveMethod(method, token, typeArguments, methodArguments));
+				else if (opCode == OpCodes.Calli || opCode == OpCodes.Jmp || opCode == OpCodes.Mkrefany)
+					GiveUp();
+
+				if (!_isComplete)
+					return;
+			}
+		}
+
+		/// <summary>
+		///   Analyzes a call of the <paramref name="target" /> method made by the <paramref name="caller" />.
+		/// </summary>
+		private void AnalyzeCall(MethodBase caller, MethodBase target, OpCode opCode)
+		{
+			if (target == null)
+				return;
+
+			var declaringType = target.DeclaringType;
+			var isFrameworkMethod = IsFrameworkType(declaringType);
+
+			if (opCode == OpCodes.Newobj && declaringType != null)
+				_candidateTypes.Add(declaringType);
+
+			// Delegates are either referenced by the model or created by reachable code, in which case their targets are
+			// already known to be reachable due to the corresponding ldftn instructions
+			if (declaringType != null && typeof(Delegate).IsAssignableFrom(declaringType))
+			{
+				if (opCode == OpCodes.Newobj)
+					return;
+
+				if (target.Name == "Invoke")
+				{
+					foreach (var d in _delegates.Where(d => declaringType.IsInstanceOfType(d)))
+						AddDelegateTargets(d);
+					return;
+				}
+			}
+
+			if (opCode == OpCodes.Callvirt && target.IsVirtual && !target.IsFinal)
+				AddVirtualCallTargets((MethodInfo)target);
+
+			if (!isFrameworkMethod)
+			{
+				if (opCode != OpCodes.Callvirt || !target.IsVirtual || target.IsFinal)
+					AddReachableMethod(target);
+
+				return;
+			}
+
+			// We assume that the infrastructure never passes model state to the framework
+			if (InfrastructureAssemblies.Contains(caller.DeclaringType?.Assembly) || IsPureFrameworkType(declaringType))
+				return;
+
+			// Constructors of framework types create new objects, but might read existing ones such as lists that are copied
+			AccessSlots(_frameworkSlots, read: true, write: opCode != OpCodes.Newobj);
+			AddFrameworkCallbacks();
+		}
+
+		/// <summary>
+		///   Adds all model methods that might be invoked by the framework as reachable.
+		/// </summary>
+		private void AddFrameworkCallbacks()
+		{
+			if (_frameworkCallbacksAdded)
+				return;
+
+			_frameworkCallbacksAdded = true;
+
+			foreach (var d in _delegates)
+				AddDelegateTargets(d);
+
+			foreach (var type in _candidateTypes.Where(type => !IsFrameworkType(type)).ToArray())
+			{
+				foreach (var method in typeof(object).GetMethods().Where(method => method.IsVirtual))
+					AddReachableMethod(ResolveVirtualCall(type, method));
+
+				if (type.IsInterface)
+					continue;
+
+				foreach (var interfaceType in type.GetInterfaces().Where(IsFrameworkType))
+				{
+					foreach (var method in type.GetInterfaceMap(interfaceType).TargetMethods)
+						AddReachableMethod(method);
+				}
+			}
+		}
+
+		/// <summary>
+		///   Adds the methods invoked by the delegate <paramref name="d" /> as reachable.
+		/// </summary>
+		private void AddDelegateTargets(Delegate d)
+		{
+			foreach (var invocation in d.GetInvocationList())
+				AddReachableMethod(invocation.Method);
+		}
+
+		/// <summary>
+		///   Adds all targets of virtual calls of <paramref name="method" /> as reachable.
+		/// </summary>
+		private void AddVirtualCallTargets(MethodInfo method)
+		{
+			if (method == null)
+				return;
+
+			if (!method.IsVirtual || method.IsFinal)
+			{
+				AddReachableMethod(method);
+				return;
+			}
+
+			_virtualCalls.Add(method);
+
+			if (!method.IsAbstract)
+				AddReachableMethod(method);
+
+			foreach (var type in _candidateTypes.Where(type => method.DeclaringType.IsAssignableFrom(type)).ToArray())
+			{
+				if (type.IsAbstract || type.IsInterface || IsFrameworkType(type) && IsFrameworkType(method.DeclaringType))
+					continue;
+
+				var target = ResolveVirtualCall(type, method);
+				if (target == null)
+				{
+					// Fall back to all methods of the type with a matching name
+					foreach (var candidate in GetMethodsInHierarchy(type).Where(m => m.Name == method.Name || m.Name.EndsWith("." + method.Name)))
+						AddReachableMethod(candidate);
+				}
+				else if (!IsFrameworkType(target.DeclaringType))
+					AddReachableMethod(target);
+			}
+		}
+
+		/// <summary>
+		///   Adds the <paramref name="method" /> as reachable.
+		/// </summary>
+		private void AddReachableMethod(MethodBase method)
+		{
+			if (method == null || !_reachableMethods.Add(method))
+				return;
+
+			if (IsFrameworkType(method.DeclaringType))
+				return;
+
+			if (method.IsAbstract)
+				return;
+
+			_worklist.Enqueue(method);
+		}
+
+		/// <summary>
+		///   Gets the instructions of the <paramref name="method" /> that are reachable, taking fault activations that are known to
+		///   be impossible into account.
+		/// </summary>
+		private IEnumerable<Instruction> GetReachableInstructions(MethodBase method, Instruction[] instructions, Type[] typeArguments,
+																 Type[] methodArguments)
+		{
+			var indices = new Dictionary<int, int>();
+			for (var i = 0; i < instructions.Length; ++i)
+				indices.Add(instructions[i].Offset, i);
+
+			var prunedBranches = GetPrunedBranches(method, instructions, typeArguments, methodArguments);
+			var reachable = new bool[instructions.Length];
+			var stack = new Stack<int>();
+
+			stack.Push(0);
+			foreach (var clause in method.GetMethodBody().ExceptionHandlingClauses)
+			{
+				stack.Push(indices[clause.HandlerOffset]);
+				if (clause.Flags == ExceptionHandlingClauseOptions.Filter)
+					stack.Push(indices[clause.FilterOffset]);
+			}
+
+			while (stack.Count > 0)
+			{
+				var index = stack.Pop();
+				if (index >= instructions.Length || reachable[index])
+					continue;
+
+				reachable[index] = true;
+				var instruction = instructions[index];
+
+				int prunedTarget;
+				if (!prunedBranches.TryGetValue(index, out prunedTarget))
+					prunedTarget = -1;
+
+				switch (instruction.OpCode.FlowControl)
+				{
+					case FlowControl.Return:
+					case FlowControl.Throw:
+						break;
+					case FlowControl.Branch:
+						stack.Push(indices[(int)instruction.Operand]);
+						break;
+					case FlowControl.Cond_Branch:
+						if (instruction.SwitchTargets != null)
+						{
+							foreach (var target in instruction.SwitchTargets)
+								stack.Push(indices[target]);
+						}
+						else if (prunedTarget != (int)instruction.Operand)
+							stack.Push(indices[(int)instruction.Operand]);
+
+						if (prunedTarget != instruction.NextOffset)
+							stack.Push(index + 1);
+						break;
+					default:
+						stack.Push(index + 1);
+						break;
+				}
+			}
+
+			return instructions.Where((instruction, index) => reachable[index]);
+		}
+
+		/// <summary>
+		///   Gets the branches of the <paramref name="method" /> guarded by the activation of faults that cannot be activated. The
+		///   S# compiler guards fault effects with <c>if (!FaultHelper.Activate(this.__fault__)) return base.M();</c>, which
+		///   might additionally be decorated with stores and loads of temporary locals in debug builds. The returned dictionary
+		///   maps the indices of the branch instructions to the offsets of the branch targets that cannot be taken.
+		/// </summary>
+		private Dictionary<int, int> GetPrunedBranches(MethodBase method, Instruction[] instructions, Type[] typeArguments, Type[] methodArguments)
+		{
+			var prunedBranches = new Dictionary<int, int>();
+
+			for (var i = 1; i < instructions.Length; ++i)
+			{
+				if (instructions[i].OpCode != OpCodes.Call || instructions[i - 1].OpCode != OpCodes.Ldfld)
+					continue;
+
+				var target = ResolveMethod(method, (int)instructions[i].Operand, typeArguments, methodArguments);
+				if (target?.Name != "Activate" || target.DeclaringType?.Name != "FaultHelper")
+					continue;
+
+				var faultField = ResolveField(method, (int)instructions[i - 1].Operand, typeArguments, methodArguments);
+				if (faultField == null || GetFaults(faultField).Any(fault => fault == null || _canBeActivated(fault)))
+					continue;
+
+				// Find the branch on the activation result
+				var negated = false;
+				var index = i + 1;
+
+				if (index + 1 < instructions.Length && instructions[index].OpCode == OpCodes.Ldc_I4_0 && instructions[index + 1].OpCode == OpCodes.Ceq)
+				{
+					negated = true;
+					index += 2;
+				}
+
+				if (index + 1 < instructions.Length && instructions[index].OpCode.Name.StartsWith("stloc") &&
+					instructions[index + 1].OpCode.Name.StartsWith("ldloc") && instructions[index].LocalIndex == instructions[index + 1].LocalIndex)
+				{
+					index += 2;
+				}
+
+				if (index >= instructions.Length)
+					continue;
+
+				var branch = instructions[index];
+				bool branchesOnActivation;
+
+				if (branch.OpCode == OpCodes.Brtrue || branch.OpCode == OpCodes.Brtrue_S)
+					branchesOnActivation = !negated;
+				else if (branch.OpCode == OpCodes.Brfalse || branch.OpCode == OpCodes.Brfalse_S)
+					branchesOnActivation = negated;
+				else
+					continue;
+
+				prunedBranches.Add(index, branchesOnActivation ? (int)branch.Operand : branch.NextOffset);
+			}
+
+			return prunedBranches;
+		}
+
+		/// <summary>
+		///   Gets the faults stored in the fault effect field <paramref name="faultField" /> of all components.
+		/// </summary>
+		private Fault[] GetFaults(FieldInfo faultField)
+		{
+			Fault[] faults;
+			if (_faultFields.TryGetValue(faultField, out faults))
+				return faults;
+
+			faults = _model.Objects
+						   .OfType<Component>()
+						   .Where(component => faultField.DeclaringType.IsInstanceOfType(component))
+						   .Select(component => faultField.GetValue(component) as Fault)
+						   .Where(fault => fault != null)
+						   .ToArray();
+
+			// If we cannot find any faults, we cannot prune anything
+			if (faults.Length == 0 || !typeof(Fault).IsAssignableFrom(faultField.FieldType))
+				faults = new Fault[] { null };
+
+			_faultFields.Add(faultField, faults);
+			return faults;
+		}
+
+		/// <summary>
+		///   Marks the state slots of the <paramref name="field" /> as accessed.
+		/// </summary>
+		private void AccessField(FieldInfo field, bool read, bool write)
+		{
+			List<int> slots;
+			if (field != null && _fieldSlots.TryGetValue(new FieldKey(field), out slots))
+				AccessSlots(slots, read, write);
+		}
+
+		/// <summary>
+		///   Marks the <paramref name="slots" /> as accessed.
+		/// </summary>
+		private void AccessSlots(List<int> slots, bool read, bool write)
+		{
+			foreach (var slot in slots)
+			{
+				_reads[slot] |= read;
+				_writes[slot] |= write;
+			}
+		}
+
+		/// <summary>
+		///   Stops the analysis, marking its results as incomplete.
+		/// </summary>
+		private void GiveUp()
+		{
+			_isComplete = false;
+		}
+
+		/// <summary>
+		///   Resolves the field with the given <paramref name="token" /> in the context of the <paramref name="method" />.
+		/// </summary>
+		private FieldInfo ResolveField(MethodBase method, int token, Type[] typeArguments, Type[] methodArguments)
+		{
+			try
+			{
+				return method.Module.ResolveField(token, typeArguments, methodArguments);
+			}
+			catch (ArgumentException)
+			{
+				GiveUp();
+				return null;
+			}
+		}
+
+		/// <summary>
+		///   Resolves the method with the given <paramref name="token" /> in the context of the <paramref name="method" />.
+		/// </summary>
+		private MethodBase ResolveMethod(MethodBase method, int token, Type[] typeArguments, Type[] methodArguments)
+		{
+			try
+			{
+				return method.Module.ResolveMethod(token, typeArguments, methodArguments);
+			}
+			catch (ArgumentException)
+			{
+				GiveUp();
+				return null;
+			}
+		}
+
+		/// <summary>
+		///   Resolves the implementation of the virtual <paramref name="method" /> invoked on an instance of <paramref name="type" />.
+		///   Returns <c>null</c> if the implementation cannot be determined.
+		/// </summary>
+		private static MethodInfo ResolveVirtualCall(Type type, MethodInfo method)
+		{
+			var definition = method.IsGenericMethod ? method.GetGenericMethodDefinition() : method;
+			MethodInfo target = null;
+
+			if (method.DeclaringType.IsInterface)
+			{
+				if (type.IsArray || type.IsInterface)
+					return null;
+
+				try
+				{
+					var map = type.GetInterfaceMap(method.DeclaringType);
+					for (var i = 0; i < map.InterfaceMethods.Length && target == null; ++i)
+					{
+						if (IsSameMethod(map.InterfaceMethods[i], definition))
+							target = map.TargetMethods[i];
+					}
+				}
+				catch (ArgumentException)
+				{
+					return null;
+				}
+			}
+			else
+			{
+				var baseDefinition = definition.GetBaseDefinition();
+				for (var t = type; t != null && target == null; t = t.BaseType)
+				{
+					target = t.GetMethods(DeclaredMembers)
+							  .FirstOrDefault(m => m.IsVirtual && m.Name == definition.Name && IsSameMethod(m.GetBaseDefinition(), baseDefinition));
+				}
+			}
+
+			if (target != null && method.IsGenericMethod && target.IsGenericMethodDefinition)
+				target = target.MakeGenericMethod(method.GetGenericArguments());
+
+			return target;
+		}
+
+		/// <summary>
+		///   Checks whether <paramref name="method1" /> and <paramref name="method2" /> refer to the same method definition.
+		/// </summary>
+		private static bool IsSameMethod(MethodBase method1, MethodBase method2)
+		{
+			return method1.Module == method2.Module && method1.MetadataToken == method2.MetadataToken;
+		}
+
+		/// <summary>
+		///   Gets all methods declared by <paramref name="type" /> or one of its base types.
+		/// </summary>
+		private static IEnumerable<MethodInfo> GetMethodsInHierarchy(Type type)
+		{
+			for (var t = type; t != null; t = t.BaseType)
+			{
+				foreach (var method in t.GetMethods(DeclaredMembers))
+					yield return method;
+			}
+		}
+
+		/// <summary>
+		///   Gets the field storing the fault of the fault effect <paramref name="type" />.
+		/// </summary>
+		private static FieldInfo GetFaultField(Type type)
+		{
+			return type.GetField("__fault__", BindingFlags.Instance | BindingFlags.NonPublic | BindingFlags.DeclaredOnly);
+		}
+
+		/// <summary>
+		///   Checks whether the <paramref name="method" /> undoes fault activations.
+		/// </summary>
+		private static bool CallsUndoActivation(MethodBase method)
+		{
+			Instruction[] instructions;
+			try
+			{
+				instructions = MethodBodyReader.GetInstructions(method);
+			}
+			catch (InvalidOperationException)
+			{
+				return true;
+			}
+
+			if (instructions == null)
+				return false;
+
+			var typeArguments = method.DeclaringType != null && method.DeclaringType.IsGenericType ? method.DeclaringType.GetGenericArguments() : null;
+			var methodArguments = method.IsGenericMethod ? method.GetGenericArguments() : null;
+
+			foreach (var instruction in instructions.Where(instruction => instruction.OpCode == OpCodes.Call))
+			{
+				try
+				{
+					var target = method.Module.ResolveMethod((int)instruction.Operand, typeArguments, methodArguments);
+					if (target.Name == "UndoActivation" && target.DeclaringType?.Name == "FaultHelper")
+						return true;
+				}
+				catch (ArgumentException)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		/// <summary>
+		///   Checks whether <paramref name="type" /> is defined by the .NET framework.
+		/// </summary>
+		private static bool IsFrameworkType(Type type)
+		{
+			if (type == null)
+				return true;
+
+			if (type.IsArray)
+				return true;
+
+			var assembly = type.Assembly;
+			var name = assembly.GetName().Name;
+
+			return assembly == typeof(object).Assembly || assembly.GlobalAssemblyCache || name.StartsWith("System.") || name.StartsWith("Microsoft.");
+		}
+
+		/// <summary>
+		///   Checks whether the methods of the framework <paramref name="type" /> are known not to access any model state.
+		/// </summary>
+		private static bool IsPureFrameworkType(Type type)
+		{
+			if (type.IsPrimitive || typeof(Exception).IsAssignableFrom(type))
+				return true;
+
+			var definition = type.IsGenericType ? type.GetGenericTypeDefinition() : type;
+			return PureFrameworkTypes.Contains(definition);
+		}
+
+		/// <summary>
+		///   Adds the <paramref name="slot" /> to the slots accessed via the <paramref name="field" />.
+		/// </summary>
+		private void AddFieldSlot(FieldInfo field, int slot)
+		{
+			var key = new FieldKey(field);
+
+			List<int> slots;
+			if (!_fieldSlots.TryGetValue(key, out slots))
+				_fieldSlots.Add(key, slots = new List<int>());
+
+			slots.Add(slot);
+		}
+
+		/// <summary>
+		///   Identifies a field regardless of the instantiation of its declaring type, if the type is generic.
+		/// </summary>
+		private struct FieldKey : IEquatable<FieldKey>
+		{
+			private readonly Module _module;
+			private readonly int _token;
+
+			public FieldKey(FieldInfo field)
+			{
+				_module = field.Module;
+				_token = field.MetadataToken;
+			}
+
+			public bool Equals(FieldKey other)
+			{
+				return _module == other._module && _token == other._token;
+			}
+
+			public override bool Equals(object obj)
+			{
+				return obj is FieldKey && Equals((FieldKey)obj);
+			}
+
+			public override int GetHashCode()
+			{
+				return _module.GetHashCode() * 397 ^ _token;
+			}
+		}
+	}
+}
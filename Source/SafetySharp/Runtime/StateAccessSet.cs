@@ -0,0 +1,184 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+namespace SafetySharp.Runtime
+{
+	using System.IO;
+	using System.Linq;
+	using ISSE.SafetyChecking.Utilities;
+	using Serialization;
+
+	/// <summary>
+	///   Describes the state slots of a <see cref="StateVectorLayout" /> that are read and written by some code.
+	/// </summary>
+	internal sealed class StateAccessSet
+	{
+		private readonly StateVectorLayout _layout;
+		private readonly bool[] _reads;
+		private readonly bool[] _writes;
+
+		/// <summary>
+		///   Initializes a new instance that conservatively assumes that all slots are read and written.
+		/// </summary>
+		/// <param name="layout">The layout of the state vector that is accessed.</param>
+		internal StateAccessSet(StateVectorLayout layout)
+			: this(layout, Enumerable.Repeat(true, layout.SlotCount).ToArray(), Enumerable.Repeat(true, layout.SlotCount).ToArray())
+		{
+			IsComplete = false;
+		}
+
+		/// <summary>
+		///   Initializes a new instance.
+		/// </summary>
+		/// <param name="layout">The layout of the state vector that is accessed.</param>
+		/// <param name="reads">Indicates for each slot of the <paramref name="layout" /> whether it is read.</param>
+		/// <param name="writes">Indicates for each slot of the <paramref name="layout" /> whether it is written.</param>
+		internal StateAccessSet(StateVectorLayout layout, bool[] reads, bool[] writes)
+		{
+			Requires.NotNull(layout, nameof(layout));
+			Requires.NotNull(reads, nameof(reads));
+			Requires.NotNull(writes, nameof(writes));
+			Requires.That(reads.Length == layout.SlotCount && writes.Length == layout.SlotCount, "Unexpected number of slots.");
+
+			_layout = layout;
+			_reads = reads;
+			_writes = writes;
+			IsComplete = true;
+		}
+
+		/// <summary>
+		///   Gets a value indicating whether the accesses could be determined precisely. If <c>false</c>, all slots are assumed to be
+		///   read and written.
+		/// </summary>
+		public bool IsComplete { get; }
+
+		/// <summary>
+		///   Checks whether the slot at <paramref name="index" /> is read.
+		/// </summary>
+		/// <param name="index">The index of the slot within the state vector layout.</param>
+		public bool IsRead(int index) => _reads[index];
+
+		/// <summary>
+		///   Checks whether the slot at <paramref name="index" /> is written.
+		/// </summary>
+		/// <param name="index">The index of the slot within the state vector layout.</param>
+		public bool IsWritten(int index) => _writes[index];
+
+		/// <summary>
+		///   Gets flags indicating for each 32 bit word of the state vector whether it contains a slot that is read.
+		/// </summary>
+		/// <param name="stateHeaderBytes">The number of bytes reserved at the beginning of the state vector.</param>
+		public bool[] GetReadWords(int stateHeaderBytes) => GetWords(_reads, stateHeaderBytes);
+
+		/// <summary>
+		///   Gets flags indicating for each 32 bit word of the state vector whether it contains a slot that is written.
+		/// </summary>
+		/// <param name="stateHeaderBytes">The number of bytes reserved at the beginning of the state vector.</param>
+		public bool[] GetWrittenWords(int stateHeaderBytes) => GetWords(_writes, stateHeaderBytes);
+
+		/// <summary>
+		///   Gets flags indicating for each of the <paramref name="variables" /> whether it belongs to a slot that is read.
+		/// </summary>
+		/// <param name="variables">The variables the state vector is split into.</param>
+		public bool[] GetReadVariables(StateVariable[] variables) => GetVariables(_reads, variables);
+
+		/// <summary>
+		///   Gets flags indicating for each of the <paramref name="variables" /> whether it belongs to a slot that is written.
+		/// </summary>
+		/// <param name="variables">The variables the state vector is split into.</param>
+		public bool[] GetWrittenVariables(StateVariable[] variables) => GetVariables(_writes, variables);
+
+		/// <summary>
+		///   Writes the accesses using the <paramref name="writer" />.
+		/// </summary>
+		/// <param name="writer">The writer the accesses should be written to.</param>
+		internal void Save(BinaryWriter writer)
+		{
+			Requires.NotNull(writer, nameof(writer));
+
+			writer.Write(IsComplete);
+			writer.Write(_reads.Length);
+
+			for (var i = 0; i < _reads.Length; ++i)
+			{
+				writer.Write(_reads[i]);
+				writer.Write(_writes[i]);
+			}
+		}
+
+		/// <summary>
+		///   Reads accesses of the <paramref name="layout" />'s slots using the <paramref name="reader" />.
+		/// </summary>
+		/// <param name="reader">The reader the accesses should be read from.</param>
+		/// <param name="layout">The layout of the state vector that is accessed.</param>
+		internal static StateAccessSet Load(BinaryReader reader, StateVectorLayout layout)
+		{
+			Requires.NotNull(reader, nameof(reader));
+
+			var isComplete = reader.ReadBoolean();
+			var reads = new bool[reader.ReadInt32()];
+			var writes = new bool[reads.Length];
+
+			for (var i = 0; i < reads.Length; ++i)
+			{
+				reads[i] = reader.ReadBoolean();
+				writes[i] = reader.ReadBoolean();
+			}
+
+			return isComplete ? new StateAccessSet(layout, reads, writes) : new StateAccessSet(layout);
+		}
+
+		/// <summary>
+		///   Maps the <paramref name="slots" /> to the <paramref name="variables" /> they are split into.
+		/// </summary>
+		private static bool[] GetVariables(bool[] slots, StateVariable[] variables)
+		{
+			Requires.NotNull(variables, nameof(variables));
+			return variables.Select(variable => variable.SlotIndex != -1 && slots[variable.SlotIndex]).ToArray();
+		}
+
+		/// <summary>
+		///   Maps the <paramref name="slots" /> to the 32 bit words of the state vector they are stored in.
+		/// </summary>
+		private bool[] GetWords(bool[] slots, int stateHeaderBytes)
+		{
+			Requires.That(stateHeaderBytes % 4 == 0, nameof(stateHeaderBytes), "Expected a multiple of 4.");
+
+			var words = new bool[(_layout.SizeInBytes + stateHeaderBytes) / 4];
+			var offsets = _layout.GetSlotOffsetsInBits();
+
+			for (var i = 0; i < slots.Length; ++i)
+			{
+				if (!slots[i] || _layout[i].TotalSizeInBits == 0)
+					continue;
+
+				var first = stateHeaderBytes * 8 + offsets[i];
+				var last = first + _layout[i].TotalSizeInBits - 1;
+
+				for (var word = first / 32; word <= last / 32; ++word)
+					words[word] = true;
+			}
+
+			return words;
+		}
+	}
+}
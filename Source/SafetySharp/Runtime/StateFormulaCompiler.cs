@@ -0,0 +1,787 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace SafetySharp.Runtime
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Linq;
+	using System.Reflection;
+	using System.Reflection.Emit;
+	using Analysis;
+	using ISSE.SafetyChecking.Modeling;
+	using ISSE.SafetyChecking.Utilities;
+	using Modeling;
+	using Serialization;
+	using Utilities;
+
+	/// <summary>
+	///   Compiles the expressions of <see cref="ExecutableStateFormula" /> instances into programs that evaluate the formulas
+	///   directly on serialized state vectors, i.e., without deserializing the states into the model's objects. The programs
+	///   consist of <see cref="StateFormulaOpCode" /> instructions and are executed by LtsMin's S# plugin.
+	/// </summary>
+	/// <remarks>
+	///   The compiler translates the IL of an expression and of all methods it calls, which are inlined. Object references are
+	///   resolved at compile time: references stored in the state vector are checked by <see cref="StateFormulaOpCode.Guard" />
+	///   instructions at evaluation time, whereas references that are not part of the state are assumed to never change. Only
+	///   integral values can be read from the state vector. As the programs never branch backwards, they always terminate.
+	///   Whenever the compiler encounters code it cannot translate, it gives up and the formula must be evaluated on the
+	///   deserialized model instead.
+	/// </remarks>
+	internal sealed class StateFormulaCompiler
+	{
+		/// <summary>
+		///   The maximum number of values on the stack during the evaluation of a program.
+		/// </summary>
+		public const int MaxStackSize = 64;
+
+		/// <summary>
+		///   The maximum number of local variables of a program, including the variables of all inlined methods.
+		/// </summary>
+		public const int MaxLocalCount = 64;
+
+		/// <summary>
+		///   The maximum nesting depth of inlined method calls.
+		/// </summary>
+		private const int MaxInliningDepth = 8;
+
+		private static readonly Assembly[] InfrastructureAssemblies = { typeof(Component).Assembly, typeof(Fault).Assembly };
+
+		private static readonly object RuntimeValue = new object();
+
+		private static readonly Dictionary<OpCode, int> ConstantInstructions = new Dictionary<OpCode, int>
+		{
+			[OpCodes.Ldc_I4_M1] = -1,
+			[OpCodes.Ldc_I4_0] = 0,
+			[OpCodes.Ldc_I4_1] = 1,
+			[OpCodes.Ldc_I4_2] = 2,
+			[OpCodes.Ldc_I4_3] = 3,
+			[OpCodes.Ldc_I4_4] = 4,
+			[OpCodes.Ldc_I4_5] = 5,
+			[OpCodes.Ldc_I4_6] = 6,
+			[OpCodes.Ldc_I4_7] = 7,
+			[OpCodes.Ldc_I4_8] = 8
+		};
+
+		private static readonly Dictionary<OpCode, StateFormulaOpCode> UnaryInstructions = new Dictionary<OpCode, StateFormulaOpCode>
+		{
+			[OpCodes.Not] = StateFormulaOpCode.Not,
+			[OpCodes.Neg] = StateFormulaOpCode.Negate
+		};
+
+		private static readonly Dictionary<OpCode, StateFormulaOpCode> BinaryInstructions = new Dictionary<OpCode, StateFormulaOpCode>
+		{
+			[OpCodes.Add] = StateFormulaOpCode.Add,
+			[OpCodes.Sub] = StateFormulaOpCode.Subtract,
+			[OpCodes.Mul] = StateFormulaOpCode.Multiply,
+			[OpCodes.And] = StateFormulaOpCode.And,
+			[OpCodes.Or] = StateFormulaOpCode.Or,
+			[OpCodes.Xor] = StateFormulaOpCode.Xor,
+			[OpCodes.Shl] = StateFormulaOpCode.ShiftLeft,
+			[OpCodes.Shr] = StateFormulaOpCode.ShiftRight,
+			[OpCodes.Shr_Un] = StateFormulaOpCode.ShiftRightUnsigned,
+			[OpCodes.Ceq] = StateFormulaOpCode.Equal,
+			[OpCodes.Clt] = StateFormulaOpCode.Less,
+			[OpCodes.Clt_Un] = StateFormulaOpCode.LessUnsigned,
+			[OpCodes.Cgt] = StateFormulaOpCode.Greater,
+			[OpCodes.Cgt_Un] = StateFormulaOpCode.GreaterUnsigned
+		};
+
+		// Comparing branches are translated into a comparison followed by a conditional jump
+		private static readonly Dictionary<OpCode, Tuple<StateFormulaOpCode, StateFormulaOpCode>> ComparingBranchInstructions =
+			new Dictionary<OpCode, Tuple<StateFormulaOpCode, StateFormulaOpCode>>
+			{
+				[OpCodes.Beq] = Tuple.Create(StateFormulaOpCode.Equal, StateFormulaOpCode.JumpIfTrue),
+				[OpCodes.Beq_S] = Tuple.Create(StateFormulaOpCode.Equal, StateFormulaOpCode.JumpIfTrue),
+				[OpCodes.Bne_Un] = Tuple.Create(StateFormulaOpCode.Equal, StateFormulaOpCode.JumpIfFalse),
+				[OpCodes.Bne_Un_S] = Tuple.Create(StateFormulaOpCode.Equal, StateFormulaOpCode.JumpIfFalse),
+				[OpCodes.Bge] = Tuple.Create(StateFormulaOpCode.Less, StateFormulaOpCode.JumpIfFalse),
+				[OpCodes.Bge_S] = Tuple.Create(StateFormulaOpCode.Less, StateFormulaOpCode.JumpIfFalse),
+				[OpCodes.Bge_Un] = Tuple.Create(StateFormulaOpCode.LessUnsigned, StateFormulaOpCode.JumpIfFalse),
+				[OpCodes.Bge_Un_S] = Tuple.Create(StateFormulaOpCode.LessUnsigned, StateFormulaOpCode.JumpIfFalse),
+				[OpCodes.Bgt] = Tuple.Create(StateFormulaOpCode.Greater, StateFormulaOpCode.JumpIfTrue),
+				[OpCodes.Bgt_S] = Tuple.Create(StateFormulaOpCode.Greater, StateFormulaOpCode.JumpIfTrue),
+				[OpCodes.Bgt_Un] = Tuple.Create(StateFormulaOpCode.GreaterUnsigned, StateFormulaOpCode.JumpIfTrue),
+				[OpCodes.Bgt_Un_S] = Tuple.Create(StateFormulaOpCode.GreaterUnsigned, StateFormulaOpCode.JumpIfTrue),
+				[OpCodes.Ble] = Tuple.Create(StateFormulaOpCode.Greater, StateFormulaOpCode.JumpIfFalse),
+				[OpCodes.Ble_S] = Tuple.Create(StateFormulaOpCode.Greater, StateFormulaOpCode.JumpIfFalse),
+				[OpCodes.Ble_Un] = Tuple.Create(StateFormulaOpCode.GreaterUnsigned, StateFormulaOpCode.JumpIfFalse),
+				[OpCodes.Ble_Un_S] = Tuple.Create(StateFormulaOpCode.GreaterUnsigned, StateFormulaOpCode.JumpIfFalse),
+				[OpCodes.Blt] = Tuple.Create(StateFormulaOpCode.Less, StateFormulaOpCode.JumpIfTrue),
+				[OpCodes.Blt_S] = Tuple.Create(StateFormulaOpCode.Less, StateFormulaOpCode.JumpIfTrue),
+				[OpCodes.Blt_Un] = Tuple.Create(StateFormulaOpCode.LessUnsigned, StateFormulaOpCode.JumpIfTrue),
+				[OpCodes.Blt_Un_S] = Tuple.Create(StateFormulaOpCode.LessUnsigned, StateFormulaOpCode.JumpIfTrue)
+			};
+
+		private readonly ObjectTable _objectTable;
+		private readonly HashSet<object> _serializedObjects;
+		private readonly HashSet<SlotKey> _serializedFields = new HashSet<SlotKey>();
+		private readonly Dictionary<SlotKey, StateVariable> _variables = new Dictionary<SlotKey, StateVariable>();
+
+		// The state of the current compilation
+		private int _localCount;
+		private List<int> _program;
+		private int _stackSize;
+
+		/// <summary>
+		///   Initializes a new instance.
+		/// </summary>
+		/// <param name="model">The model whose formulas should be compiled.</param>
+		/// <param name="stateHeaderBytes">The number of bytes preceding the model's state in the evaluated state vectors.</param>
+		public StateFormulaCompiler(SafetySharpRuntimeModel model, int stateHeaderBytes)
+		{
+			Requires.NotNull(model, nameof(model));
+
+			_objectTable = model.SerializedObjects;
+			_serializedObjects = new HashSet<object>(_objectTable, ReferenceEqualityComparer<object>.Default);
+
+			foreach (var slot in model.StateVectorLayout.Where(slot => slot.Field != null && !slot.ContainedInStruct))
+				_serializedFields.Add(new SlotKey(slot.Object, slot.Field));
+
+			// Only fields whose values are stored in a single state variable can be read by the programs
+			foreach (var variable in model.StateVectorLayout.GetStateVariables(stateHeaderBytes).Where(variable => variable.SlotIndex >= 0))
+			{
+				var slot = model.StateVectorLayout[variable.SlotIndex];
+				if (slot.Field != null && !slot.ContainedInStruct && slot.ElementCount == 1 && slot.ElementSizeInBits <= 32)
+					_variables[new SlotKey(slot.Object, slot.Field)] = variable;
+			}
+		}
+
+		/// <summary>
+		///   Compiles the <paramref name="formula" />. Returns <c>null</c> if the formula's expression cannot be compiled.
+		/// </summary>
+		/// <param name="formula">The formula that should be compiled.</param>
+		public int[] Compile(ExecutableStateFormula formula)
+		{
+			Requires.NotNull(formula, nameof(formula));
+
+			var invocations = formula.Expression.GetInvocationList();
+			if (invocations.Length != 1)
+				return null;
+
+			var method = invocations[0].Method;
+			var target = invocations[0].Target;
+
+			if (method.IsStatic && target != null)
+				return null;
+
+			_localCount = 0;
+			_program = new List<int>();
+			_stackSize = 0;
+
+			var arguments = method.IsStatic ? new object[0] : new[] { target };
+			return CompileMethod(method, arguments, isInlined: false, depth: 0) ? _program.ToArray() : null;
+		}
+
+		/// <summary>
+		///   Compiles the <paramref name="method" /> invoked with the <paramref name="arguments" />, which are either known objects or
+		///   the <see cref="LocalVariable" /> instances storing the arguments' values.
+		/// </summary>
+		private bool CompileMethod(MethodBase method, object[] arguments, bool isInlined, int depth)
+		{
+			if (depth > MaxInliningDepth || method.IsAbstract || IsFrameworkType(method.DeclaringType))
+				return false;
+
+			var returnType = ((MethodInfo)method).ReturnType;
+			if (returnType != typeof(void) && !IsIntegralType(returnType))
+				return false;
+
+			MethodBody body;
+			Instruction[] instructions;
+			try
+			{
+				body = method.GetMethodBody();
+				instructions = MethodBodyReader.GetInstructions(method);
+			}
+			catch (InvalidOperationException)
+			{
+				return false;
+			}
+			catch (NotSupportedException)
+			{
+				return false;
+			}
+
+			if (instructions == null || body.ExceptionHandlingClauses.Count > 0)
+				return false;
+
+			var context = new MethodContext
+			{
+				Method = method,
+				Arguments = arguments,
+				Depth = depth,
+				IsInlined = isInlined,
+				LocalTypes = body.LocalVariables.Select(local => local.LocalType).ToArray(),
+				LocalBase = _localCount,
+				StackBase = _stackSize,
+				TypeArguments = method.DeclaringType != null && method.DeclaringType.IsGenericType ? method.DeclaringType.GetGenericArguments() : null,
+				MethodArguments = method.IsGenericMethod ? method.GetGenericArguments() : null
+			};
+
+			_localCount += context.LocalTypes.Length;
+			if (_localCount > MaxLocalCount)
+				return false;
+
+			var isReachable = true;
+			foreach (var instruction in instructions)
+			{
+				int stackSize;
+				if (context.TargetStackSizes.TryGetValue(instruction.Offset, out stackSize))
+				{
+					// All paths reaching a branch target must agree on the values on the stack, which must not be known objects
+					if (isReachable && (context.Stack.Count != stackSize || context.Stack.Any(value => value != RuntimeValue)))
+						return false;
+
+					context.Stack.Clear();
+					context.Stack.AddRange(Enumerable.Repeat(RuntimeValue, stackSize));
+					_stackSize = context.StackBase + stackSize;
+
+					foreach (var jump in context.PendingJumps[instruction.Offset])
+						_program[jump] = _program.Count;
+
+					context.PendingJumps.Remove(instruction.Offset);
+					isReachable = true;
+				}
+
+				if (!isReachable)
+					continue;
+
+				if (!CompileInstruction(context, instruction, ref isReachable))
+					return false;
+			}
+
+			if (context.PendingJumps.Count != 0)
+				return false;
+
+			foreach (var jump in context.Returns)
+				_program[jump] = _program.Count;
+
+			return true;
+		}
+
+		/// <summary>
+		///   Compiles the <paramref name="instruction" /> of the method described by the <paramref name="context" />.
+		/// </summary>
+		private bool CompileInstruction(MethodContext context, Instruction instruction, ref bool isReachable)
+		{
+			var opCode = instruction.OpCode;
+			var formulaOpCode = default(StateFormulaOpCode);
+			var constant = 0;
+			Tuple<StateFormulaOpCode, StateFormulaOpCode> comparison;
+
+			if (opCode == OpCodes.Nop || opCode == OpCodes.Conv_I4 || opCode == OpCodes.Conv_U4)
+				return opCode == OpCodes.Nop || IsRuntimeValue(context, 0);
+
+			if (ConstantInstructions.TryGetValue(opCode, out constant) || opCode == OpCodes.Ldc_I4_S || opCode == OpCodes.Ldc_I4)
+			{
+				if (opCode == OpCodes.Ldc_I4_S || opCode == OpCodes.Ldc_I4)
+					constant = (int)instruction.Operand;
+
+				Emit(StateFormulaOpCode.Constant, constant);
+				return PushRuntimeValue(context);
+			}
+
+			if (UnaryInstructions.TryGetValue(opCode, out formulaOpCode))
+			{
+				Emit(formulaOpCode);
+				return PopRuntimeValue(context) && PushRuntimeValue(context);
+			}
+
+			if (BinaryInstructions.TryGetValue(opCode, out formulaOpCode))
+			{
+				Emit(formulaOpCode);
+				return PopRuntimeValue(context) && PopRuntimeValue(context) && PushRuntimeValue(context);
+			}
+
+			if (ComparingBranchInstructions.TryGetValue(opCode, out comparison))
+			{
+				Emit(comparison.Item1);
+				return PopRuntimeValue(context) && PopRuntimeValue(context) && EmitJump(context, comparison.Item2, instruction);
+			}
+
+			if (opCode == OpCodes.Brtrue || opCode == OpCodes.Brtrue_S)
+				return PopRuntimeValue(context) && EmitJump(context, StateFormulaOpCode.JumpIfTrue, instruction);
+
+			if (opCode == OpCodes.Brfalse || opCode == OpCodes.Brfalse_S)
+				return PopRuntimeValue(context) && EmitJump(context, StateFormulaOpCode.JumpIfFalse, instruction);
+
+			if (opCode == OpCodes.Br || opCode == OpCodes.Br_S)
+			{
+				isReachable = false;
+				return EmitJump(context, StateFormulaOpCode.Jump, instruction);
+			}
+
+			if (opCode == OpCodes.Ret)
+			{
+				isReachable = false;
+				return CompileReturn(context);
+			}
+
+			if (opCode == OpCodes.Dup)
+			{
+				if (context.Stack.Count == 0)
+					return false;
+
+				var value = context.Stack[context.Stack.Count - 1];
+				if (value != RuntimeValue)
+				{
+					context.Stack.Add(value);
+					return true;
+				}
+
+				Emit(StateFormulaOpCode.Duplicate);
+				return PushRuntimeValue(context);
+			}
+
+			if (opCode == OpCodes.Pop)
+			{
+				if (context.Stack.Count == 0)
+					return false;
+
+				if (context.Stack[context.Stack.Count - 1] != RuntimeValue)
+				{
+					context.Stack.RemoveAt(context.Stack.Count - 1);
+					return true;
+				}
+
+				Emit(StateFormulaOpCode.Pop);
+				return PopRuntimeValue(context);
+			}
+
+			var argumentIndex = GetArgumentIndex(instruction);
+			if (argumentIndex >= 0)
+			{
+				if (argumentIndex >= context.Arguments.Length)
+					return false;
+
+				var local = context.Arguments[argumentIndex] as LocalVariable;
+				if (local == null)
+				{
+					context.Stack.Add(context.Arguments[argumentIndex]);
+					return true;
+				}
+
+				Emit(StateFormulaOpCode.LoadLocal, local.Index);
+				return PushRuntimeValue(context);
+			}
+
+			var localIndex = instruction.LocalIndex;
+			if (localIndex >= 0)
+			{
+				if (localIndex >= context.LocalTypes.Length || !IsIntegralType(context.LocalTypes[localIndex]))
+					return false;
+
+				if (opCode.Name.StartsWith("ldloc"))
+				{
+					Emit(StateFormulaOpCode.LoadLocal, context.LocalBase + localIndex);
+					return PushRuntimeValue(context);
+				}
+
+				Emit(StateFormulaOpCode.StoreLocal, context.LocalBase + localIndex);
+				return PopRuntimeValue(context);
+			}
+
+			if (opCode == OpCodes.Ldfld)
+				return CompileFieldAccess(context, ResolveField(context, instruction));
+
+			if (opCode == OpCodes.Ldsfld)
+				return CompileStaticFieldAccess(context, ResolveField(context, instruction));
+
+			if (opCode == OpCodes.Call || opCode == OpCodes.Callvirt)
+				return CompileCall(context, ResolveMethod(context, instruction), opCode);
+
+			return false;
+		}
+
+		/// <summary>
+		///   Compiles the return from the method described by the <paramref name="context" />.
+		/// </summary>
+		private bool CompileReturn(MethodContext context)
+		{
+			var returnsValue = ((MethodInfo)context.Method).ReturnType != typeof(void);
+			if (context.Stack.Count != (returnsValue ? 1 : 0))
+				return false;
+
+			if (!context.IsInlined)
+			{
+				Emit(StateFormulaOpCode.Return);
+				return PopRuntimeValue(context);
+			}
+
+			// The returned value, if any, remains on the stack for the caller; the caller's code follows the inlined method
+			Emit(StateFormulaOpCode.Jump, 0);
+			context.Returns.Add(_program.Count - 1);
+
+			return !returnsValue || PopRuntimeValue(context);
+		}
+
+		/// <summary>
+		///   Compiles a read of the instance <paramref name="field" />.
+		/// </summary>
+		private bool CompileFieldAccess(MethodContext context, FieldInfo field)
+		{
+			object obj;
+			if (field == null || field.IsStatic || !PopObject(context, out obj))
+				return false;
+
+			var key = new SlotKey(obj, field);
+			var value = field.GetValue(obj);
+
+			if (_serializedFields.Contains(key))
+			{
+				StateVariable variable;
+				if (!_variables.TryGetValue(key, out variable))
+					return false;
+
+				if (IsIntegralType(field.FieldType))
+				{
+					Emit(StateFormulaOpCode.Load, variable.OffsetInBits, variable.SizeInBits, variable.IsSigned ? 1 : 0);
+					return PushRuntimeValue(context);
+				}
+
+				// References stored in the state vector are resolved at compile time; the evaluation is aborted whenever the
+				// state references another object
+				if (!field.FieldType.IsReferenceType() || value == null || !_serializedObjects.Contains(value))
+					return false;
+
+				Emit(StateFormulaOpCode.Guard, variable.OffsetInBits, variable.SizeInBits, _objectTable.GetObjectIdentifier(value));
+				context.Stack.Add(value);
+				return true;
+			}
+
+			// Fields not stored in the state vector can only be relied upon if they cannot change, i.e., if they are read-only or
+			// if their objects are not part of the model's state at all, such as the closures of the formulas
+			if (!field.IsInitOnly && _serializedObjects.Contains(obj))
+				return false;
+
+			return PushConstant(context, field.FieldType, value);
+		}
+
+		/// <summary>
+		///   Compiles a read of the static <paramref name="field" />, which must be read-only.
+		/// </summary>
+		private bool CompileStaticFieldAccess(MethodContext context, FieldInfo field)
+		{
+			if (field == null || !field.IsStatic || !(field.IsInitOnly || field.IsLiteral) || field.FieldType.ContainsGenericParameters)
+				return false;
+
+			return PushConstant(context, field.FieldType, field.GetValue(null));
+		}
+
+		/// <summary>
+		///   Compiles a call of the <paramref name="method" /> by inlining it.
+		/// </summary>
+		private bool CompileCall(MethodContext context, MethodBase method, OpCode opCode)
+		{
+			if (!(method is MethodInfo) || InfrastructureAssemblies.Contains(method.DeclaringType?.Assembly))
+				return false;
+
+			// Virtual calls might be dispatched to fault effects depending on the faults' activations, which is not part of the state
+			if (opCode == OpCodes.Callvirt && method.IsVirtual && !method.IsFinal)
+				return false;
+
+			var parameters = method.GetParameters();
+			var arguments = new object[parameters.Length + (method.IsStatic ? 0 : 1)];
+
+			for (var i = parameters.Length - 1; i >= 0; --i)
+			{
+				var argumentIndex = i + (method.IsStatic ? 0 : 1);
+				var parameterType = parameters[i].ParameterType;
+
+				if (IsIntegralType(parameterType))
+				{
+					var local = new LocalVariable(_localCount++);
+					if (_localCount > MaxLocalCount)
+						return false;
+
+					Emit(StateFormulaOpCode.StoreLocal, local.Index);
+					arguments[argumentIndex] = local;
+
+					if (!PopRuntimeValue(context))
+						return false;
+				}
+				else if (!parameterType.IsReferenceType() || !PopObject(context, out arguments[argumentIndex]))
+					return false;
+			}
+
+			if (!method.IsStatic && !PopObject(context, out arguments[0]))
+				return false;
+
+			if (!CompileMethod(method, arguments, isInlined: true, depth: context.Depth + 1))
+				return false;
+
+			return ((MethodInfo)method).ReturnType == typeof(void) || PushRuntimeValue(context);
+		}
+
+		/// <summary>
+		///   Emits a jump of the given <paramref name="kind" /> to the target of the branch <paramref name="instruction" />.
+		/// </summary>
+		private bool EmitJump(MethodContext context, StateFormulaOpCode kind, Instruction instruction)
+		{
+			var target = (int)instruction.Operand;
+			if (target <= instruction.Offset || context.Stack.Any(value => value != RuntimeValue))
+				return false;
+
+			int stackSize;
+			if (context.TargetStackSizes.TryGetValue(target, out stackSize) && stackSize != context.Stack.Count)
+				return false;
+
+			context.TargetStackSizes[target] = context.Stack.Count;
+
+			List<int> jumps;
+			if (!context.PendingJumps.TryGetValue(target, out jumps))
+				context.PendingJumps.Add(target, jumps = new List<int>());
+
+			Emit(kind, 0);
+			jumps.Add(_program.Count - 1);
+
+			return true;
+		}
+
+		/// <summary>
+		///   Emits an instruction with the given <paramref name="opCode" /> and <paramref name="operands" />.
+		/// </summary>
+		private void Emit(StateFormulaOpCode opCode, params int[] operands)
+		{
+			_program.Add((int)opCode);
+			_program.AddRange(operands);
+		}
+
+		/// <summary>
+		///   Pushes the constant <paramref name="value" /> of the given <paramref name="type" /> onto the stack.
+		/// </summary>
+		private bool PushConstant(MethodContext context, Type type, object value)
+		{
+			if (IsIntegralType(type))
+			{
+				Emit(StateFormulaOpCode.Constant, GetIntegralValue(value));
+				return PushRuntimeValue(context);
+			}
+
+			if (!type.IsReferenceType() || value == null)
+				return false;
+
+			context.Stack.Add(value);
+			return true;
+		}
+
+		/// <summary>
+		///   Pushes a value that is only known during the evaluation onto the stack.
+		/// </summary>
+		private bool PushRuntimeValue(MethodContext context)
+		{
+			context.Stack.Add(RuntimeValue);
+			return ++_stackSize <= MaxStackSize;
+		}
+
+		/// <summary>
+		///   Pops a value that is only known during the evaluation from the stack.
+		/// </summary>
+		private bool PopRuntimeValue(MethodContext context)
+		{
+			if (!IsRuntimeValue(context, 0))
+				return false;
+
+			context.Stack.RemoveAt(context.Stack.Count - 1);
+			--_stackSize;
+			return true;
+		}
+
+		/// <summary>
+		///   Pops an object known at compile time from the stack.
+		/// </summary>
+		private static bool PopObject(MethodContext context, out object obj)
+		{
+			obj = null;
+			if (context.Stack.Count == 0 || context.Stack[context.Stack.Count - 1] == RuntimeValue)
+				return false;
+
+			obj = context.Stack[context.Stack.Count - 1];
+			context.Stack.RemoveAt(context.Stack.Count - 1);
+			return true;
+		}
+
+		/// <summary>
+		///   Checks whether the stack value at the given <paramref name="depth" /> is only known during the evaluation.
+		/// </summary>
+		private static bool IsRuntimeValue(MethodContext context, int depth)
+		{
+			return context.Stack.Count > depth && context.Stack[context.Stack.Count - 1 - depth] == RuntimeValue;
+		}
+
+		/// <summary>
+		///   Gets the index of the argument loaded by the <paramref name="instruction" />, or <c>-1</c> if the instruction does not
+		///   load an argument.
+		/// </summary>
+		private static int GetArgumentIndex(Instruction instruction)
+		{
+			var opCode = instruction.OpCode;
+
+			if (opCode == OpCodes.Ldarg_0)
+				return 0;
+			if (opCode == OpCodes.Ldarg_1)
+				return 1;
+			if (opCode == OpCodes.Ldarg_2)
+				return 2;
+			if (opCode == OpCodes.Ldarg_3)
+				return 3;
+			if (opCode == OpCodes.Ldarg_S || opCode == OpCodes.Ldarg)
+				return (int)instruction.Operand;
+
+			return -1;
+		}
+
+		/// <summary>
+		///   Resolves the field referenced by the <paramref name="instruction" />.
+		/// </summary>
+		private static FieldInfo ResolveField(MethodContext context, Instruction instruction)
+		{
+			try
+			{
+				return context.Method.Module.ResolveField((int)instruction.Operand, context.TypeArguments, context.MethodArguments);
+			}
+			catch (ArgumentException)
+			{
+				return null;
+			}
+		}
+
+		/// <summary>
+		///   Resolves the method referenced by the <paramref name="instruction" />.
+		/// </summary>
+		private static MethodBase ResolveMethod(MethodContext context, Instruction instruction)
+		{
+			try
+			{
+				return context.Method.Module.ResolveMethod((int)instruction.Operand, context.TypeArguments, context.MethodArguments);
+			}
+			catch (ArgumentException)
+			{
+				return null;
+			}
+		}
+
+		/// <summary>
+		///   Checks whether values of the <paramref name="type" /> are represented as 32 bit integers on the evaluation stack.
+		/// </summary>
+		private static bool IsIntegralType(Type type)
+		{
+			if (type.IsEnum)
+				type = type.GetEnumUnderlyingType();
+
+			return type == typeof(bool) || type == typeof(char) || type == typeof(sbyte) || type == typeof(byte) ||
+				   type == typeof(short) || type == typeof(ushort) || type == typeof(int) || type == typeof(uint);
+		}
+
+		/// <summary>
+		///   Gets the 32 bit integer representation of the integral <paramref name="value" />.
+		/// </summary>
+		private static int GetIntegralValue(object value)
+		{
+			if (value is bool)
+				return (bool)value ? 1 : 0;
+
+			if (value is char)
+				return (char)value;
+
+			return unchecked((int)Convert.ToInt64(value));
+		}
+
+		/// <summary>
+		///   Checks whether <paramref name="type" /> is defined by the .NET framework.
+		/// </summary>
+		private static bool IsFrameworkType(Type type)
+		{
+			if (type == null || type.IsArray)
+				return true;
+
+			var assembly = type.Assembly;
+			var name = assembly.GetName().Name;
+
+			return assembly == typeof(object).Assembly || assembly.GlobalAssemblyCache || name.StartsWith("System.") || name.StartsWith("Microsoft.");
+		}
+
+		/// <summary>
+		///   Describes the method that is currently being compiled.
+		/// </summary>
+		private sealed class MethodContext
+		{
+			public object[] Arguments;
+			public int Depth;
+			public bool IsInlined;
+			public int LocalBase;
+			public Type[] LocalTypes;
+			public MethodBase Method;
+			public Type[] MethodArguments;
+			public readonly Dictionary<int, List<int>> PendingJumps = new Dictionary<int, List<int>>();
+			public readonly List<int> Returns = new List<int>();
+			public readonly List<object> Stack = new List<object>();
+			public int StackBase;
+			public readonly Dictionary<int, int> TargetStackSizes = new Dictionary<int, int>();
+			public Type[] TypeArguments;
+		}
+
+		/// <summary>
+		///   Represents a local variable of the program that stores the value of an argument of an inlined method.
+		/// </summary>
+		private sealed class LocalVariable
+		{
+			public readonly int Index;
+
+			public LocalVariable(int index)
+			{
+				Index = index;
+			}
+		}
+
+		/// <summary>
+		///   Identifies a field of an object.
+		/// </summary>
+		private struct SlotKey : IEquatable<SlotKey>
+		{
+			private readonly object _object;
+			private readonly Module _module;
+			private readonly int _token;
+
+			public SlotKey(object obj, FieldInfo field)
+			{
+				_object = obj;
+				_module = field.Module;
+				_token = field.MetadataToken;
+			}
+
+			public bool Equals(SlotKey other)
+			{
+				return ReferenceEquals(_object, other._object) && _module == other._module && _token == other._token;
+			}
+
+			public override bool Equals(object obj)
+			{
+				return obj is SlotKey && Equals((SlotKey)obj);
+			}
+
+			public override int GetHashCode()
+			{
+				return (System.Runtime.CompilerServices.RuntimeHelpers.GetHashCode(_object) * 397 ^ _module.GetHashCode()) * 397 ^ _token;
+			}
+		}
+	}
+}
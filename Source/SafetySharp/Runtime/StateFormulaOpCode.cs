@@ -0,0 +1,171 @@
+// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+namespace SafetySharp.Runtime
+{
+	/// <summary>
+	///   Identifies the instructions of the programs generated by the <see cref="StateFormulaCompiler" />. Each instruction
+	///   consists of its opcode followed by its operands; all values operated on are 32 bit integers. The numeric values of the
+	///   opcodes are shared with the evaluator of LtsMin's S# plugin and must not be changed.
+	/// </summary>
+	internal enum StateFormulaOpCode
+	{
+		/// <summary>
+		///   Pops a value from the stack and returns it as the result of the program.
+		/// </summary>
+		Return = 0,
+
+		/// <summary>
+		///   Pushes the constant given by the operand onto the stack.
+		/// </summary>
+		Constant = 1,
+
+		/// <summary>
+		///   Pushes a value read from the state vector onto the stack. The operands are the offset of the value in bits, the
+		///   size of the value in bits, and whether the value must be sign-extended.
+		/// </summary>
+		Load = 2,
+
+		/// <summary>
+		///   Aborts the evaluation if a value stored in the state vector does not match the expected one. The operands are the
+		///   offset of the value in bits, the size of the value in bits, and the expected value.
+		/// </summary>
+		Guard = 3,
+
+		/// <summary>
+		///   Pushes the value of the local variable with the index given by the operand onto the stack.
+		/// </summary>
+		LoadLocal = 4,
+
+		/// <summary>
+		///   Pops a value from the stack and stores it in the local variable with the index given by the operand.
+		/// </summary>
+		StoreLocal = 5,
+
+		/// <summary>
+		///   Pushes a copy of the topmost value onto the stack.
+		/// </summary>
+		Duplicate = 6,
+
+		/// <summary>
+		///   Removes the topmost value from the stack.
+		/// </summary>
+		Pop = 7,
+
+		/// <summary>
+		///   Pops two values and pushes their sum.
+		/// </summary>
+		Add = 8,
+
+		/// <summary>
+		///   Pops two values and pushes their difference.
+		/// </summary>
+		Subtract = 9,
+
+		/// <summary>
+		///   Pops two values and pushes their product.
+		/// </summary>
+		Multiply = 10,
+
+		/// <summary>
+		///   Pops two values and pushes their bitwise conjunction.
+		/// </summary>
+		And = 11,
+
+		/// <summary>
+		///   Pops two values and pushes their bitwise disjunction.
+		/// </summary>
+		Or = 12,
+
+		/// <summary>
+		///   Pops two values and pushes their bitwise exclusive disjunction.
+		/// </summary>
+		Xor = 13,
+
+		/// <summary>
+		///   Pops two values and pushes the first one shifted left by the second one.
+		/// </summary>
+		ShiftLeft = 14,
+
+		/// <summary>
+		///   Pops two values and pushes the first one arithmetically shifted right by the second one.
+		/// </summary>
+		ShiftRight = 15,
+
+		/// <summary>
+		///   Pops two values and pushes the first one logically shifted right by the second one.
+		/// </summary>
+		ShiftRightUnsigned = 16,
+
+		/// <summary>
+		///   Pops two values and pushes 1 if they are equal, 0 otherwise.
+		/// </summary>
+		Equal = 17,
+
+		/// <summary>
+		///   Pops two values and pushes 1 if the first one is less than the second one, 0 otherwise.
+		/// </summary>
+		Less = 18,
+
+		/// <summary>
+		///   Pops two values and pushes 1 if the first one is less than the second one when both are interpreted as unsigned
+		///   values, 0 otherwise.
+		/// </summary>
+		LessUnsigned = 19,
+
+		/// <summary>
+		///   Pops two values and pushes 1 if the first one is greater than the second one, 0 otherwise.
+		/// </summary>
+		Greater = 20,
+
+		/// <summary>
+		///   Pops two values and pushes 1 if the first one is greater than the second one when both are interpreted as unsigned
+		///   values, 0 otherwise.
+		/// </summary>
+		GreaterUnsigned = 21,
+
+		/// <summary>
+		///   Pops a value and pushes its bitwise complement.
+		/// </summary>
+		Not = 22,
+
+		/// <summary>
+		///   Pops a value and pushes its negation.
+		/// </summary>
+		Negate = 23,
+
+		/// <summary>
+		///   Continues the evaluation at the instruction whose index within the program is given by the operand.
+		/// </summary>
+		Jump = 24,
+
+		/// <summary>
+		///   Pops a value and continues the evaluation at the instruction whose index is given by the operand if the value is
+		///   not 0.
+		/// </summary>
+		JumpIfTrue = 25,
+
+		/// <summary>
+		///   Pops a value and continues the evaluation at the instruction whose index is given by the operand if the value is 0.
+		/// </summary>
+		JumpIfFalse = 26
+	}
+}
@@ -0,0 +1,220 @@
+﻿// The MIT License (MIT)
+// 
+// Copyright (c) 2014-2017, Institute for Software & Systems Engineering
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+namespace SafetySharp.Utilities
+{
+	using System;
+	using System.Collections.Generic;
+	using System.Reflection;
+	using System.Reflection.Emit;
+	using ISSE.SafetyChecking.Utilities;
+
+	/// <summary>
+	///   Represents a single instruction of a method body.
+	/// </summary>
+	internal struct Instruction
+	{
+		/// <summary>
+		///   The offset of the instruction within the method body.
+		/// </summary>
+		public int Offset;
+
+		/// <summary>
+		///   The offset of the instruction following the instruction within the method body.
+		/// </summary>
+		public int NextOffset;
+
+		/// <summary>
+		///   The instruction's opcode.
+		/// </summary>
+		public OpCode OpCode;
+
+		/// <summary>
+		///   The instruction's inline operand, if any. For branch instructions, the operand is the absolute offset of the branch
+		///   target; for metadata instructions, the operand is the metadata token.
+		/// </summary>
+		public long Operand;
+
+		/// <summary>
+		///   The absolute offsets of the branch targets of a switch instruction.
+		/// </summary>
+		public int[] SwitchTargets;
+
+		/// <summary>
+		///   Gets the index of the local variable that is loaded or stored by the instruction, or <c>-1</c> if the
+		///   instruction neither loads nor stores a local variable.
+		/// </summary>
+		public int LocalIndex
+		{
+			get
+			{
+				if (OpCode == OpCodes.Ldloc_0 || OpCode == OpCodes.Stloc_0)
+					return 0;
+				if (OpCode == OpCodes.Ldloc_1 || OpCode == OpCodes.Stloc_1)
+					return 1;
+				if (OpCode == OpCodes.Ldloc_2 || OpCode == OpCodes.Stloc_2)
+					return 2;
+				if (OpCode == OpCodes.Ldloc_3 || OpCode == OpCodes.Stloc_3)
+					return 3;
+				if (OpCode == OpCodes.Ldloc_S || OpCode == OpCodes.Stloc_S || OpCode == OpCodes.Ldloc || OpCode == OpCodes.Stloc)
+					return (int)Operand;
+
+				return -1;
+			}
+		}
+
+		/// <summary>
+		///   Returns a string that represents the current object.
+		/// </summary>
+		public override string ToString()
+		{
+			return $"IL_{Offset:x4}: {OpCode.Name}";
+		}
+	}
+
+	/// <summary>
+	///   Decodes the IL instructions of method bodies.
+	/// </summary>
+	internal static class MethodBodyReader
+	{
+		/// <summary>
+		///   Maps the values of single-byte opcodes to the corresponding <see cref="OpCode" /> instances.
+		/// </summary>
+		private static readonly OpCode[] SingleByteOpCodes = new OpCode[0x100];
+
+		/// <summary>
+		///   Maps the second byte of two-byte opcodes to the corresponding <see cref="OpCode" /> instances.
+		/// </summary>
+		private static readonly OpCode[] TwoByteOpCodes = new OpCode[0x100];
+
+		/// <summary>
+		///   Initializes the type.
+		/// </summary>
+		static MethodBodyReader()
+		{
+			foreach (var field in typeof(OpCodes).GetFields(BindingFlags.Public | BindingFlags.Static))
+			{
+				var opCode = (OpCode)field.GetValue(null);
+				var value = (ushort)opCode.Value;
+
+				if (opCode.Size == 1)
+					SingleByteOpCodes[value] = opCode;
+				else
+					TwoByteOpCodes[value & 0xFF] = opCode;
+			}
+		}
+
+		/// <summary>
+		///   Decodes the instructions of the <paramref name="method" />'s body. Returns <c>null</c> when the method does not have
+		///   a body that can be inspected, for instance because it is abstract or implemented by the runtime.
+		/// </summary>
+		/// <param name="method">The method whose instructions should be returned.</param>
+		public static Instruction[] GetInstructions(MethodBase method)
+		{
+			Requires.NotNull(method, nameof(method));
+
+			MethodBody body;
+			try
+			{
+				body = method.GetMethodBody();
+			}
+			catch (InvalidOperationException)
+			{
+				// Thrown for methods of dynamic types, for instance
+				return null;
+			}
+			catch (NotSupportedException)
+			{
+				// Thrown for dynamic methods, for instance
+				return null;
+			}
+
+			var il = body?.GetILAsByteArray();
+			if (il == null)
+				return null;
+
+			var instructions = new List<Instruction>();
+			var position = 0;
+
+			while (position < il.Length)
+			{
+				var instruction = new Instruction { Offset = position };
+				var value = il[position++];
+
+				instruction.OpCode = value == 0xFE ? TwoByteOpCodes[il[position++]] : SingleByteOpCodes[value];
+				if (instruction.OpCode.Size == 0)
+					throw new InvalidOperationException($"Method '{method.DeclaringType?.FullName}.{method.Name}' contains unknown opcode {value:x2}.");
+
+				switch (instruction.OpCode.OperandType)
+				{
+					case OperandType.InlineNone:
+						break;
+					case OperandType.ShortInlineBrTarget:
+						instruction.Operand = (sbyte)il[position] + position + 1;
+						position += 1;
+						break;
+					case OperandType.InlineBrTarget:
+						instruction.Operand = BitConverter.ToInt32(il, position) + position + 4;
+						position += 4;
+						break;
+					case OperandType.ShortInlineI:
+						instruction.Operand = instruction.OpCode == OpCodes.Ldc_I4_S ? (sbyte)il[position] : il[position];
+						position += 1;
+						break;
+					case OperandType.ShortInlineVar:
+						instruction.Operand = il[position];
+						position += 1;
+						break;
+					case OperandType.InlineVar:
+						instruction.Operand = BitConverter.ToUInt16(il, position);
+						position += 2;
+						break;
+					case OperandType.InlineI8:
+					case OperandType.InlineR:
+						instruction.Operand = BitConverter.ToInt64(il, position);
+						position += 8;
+						break;
+					case OperandType.InlineSwitch:
+						var count = BitConverter.ToInt32(il, position);
+						var baseOffset = position + 4 + count * 4;
+
+						instruction.SwitchTargets = new int[count];
+						for (var i = 0; i < count; ++i)
+							instruction.SwitchTargets[i] = BitConverter.ToInt32(il, position + 4 + i * 4) + baseOffset;
+
+						position = baseOffset;
+						break;
+					default:
+						// Tokens, 32 bit integers and floats
+						instruction.Operand = BitConverter.ToInt32(il, position);
+						position += 4;
+						break;
+				}
+
+				instruction.NextOffset = position;
+				instructions.Add(instruction);
+			}
+
+			return instructions.ToArray();
+		}
+	}
+}